@@ -0,0 +1,153 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <X11/keysym.h>
+#include <controller/keymap.h>
+#include <controller/opts.h>
+#include <protocol.h>
+
+
+/* macros */
+// all supported keysyms are either latin-1 (page 0x00) or
+// from the function key page (0xff), hence the low byte of
+// a keysym is a collision-free index into the page tables
+#define PAGE(sym)	((sym) >> 8)
+#define IDX(sym)	((sym) & 0xff)
+
+
+/* static variables */
+// workaround mapping to account for the blekeyboard library always using a US keyboard layout
+static uint8_t const layout_keys[256] = {
+	[IDX(XK_y)] = 'z',				// y
+	[IDX(XK_z)] = 'y',				// z
+	[IDX(XK_asciicircum)] = '`',	// ^
+	[IDX(XK_ssharp)] = '-',			// sz
+	[IDX(XK_acute)] = '=',			// ´
+	[IDX(XK_plus)] = ']',			// +
+	[IDX(XK_minus)] = '/',			// -
+	[IDX(XK_numbersign)] = '\\',	// #
+	[IDX(XK_equal)] = '\'',			// =
+	[IDX(XK_odiaeresis)] = ';',		// oe
+	[IDX(XK_adiaeresis)] = '\'',	// ae
+	[IDX(XK_udiaeresis)] = '[',		// ue
+};
+
+// Reverse effect of custom xkb file.
+//
+// The custom xkb mapping pre-translates key sequences on the xserver level, e.g. alt_l + left
+// to home. This poses a problem here since the keys sent to the target, when for instance
+// typing alt_l + left, is alt_t and home instead of alt_t and left.
+static uint8_t const reverse_xkb_keys[256] = {
+	[IDX(XK_Insert)] = NONASCII_BASE + 14,
+	[IDX(XK_Delete)] = NONASCII_BASE + 12,
+	[IDX(XK_Page_Up)] = NONASCII_BASE + 8,
+	[IDX(XK_Page_Down)] = NONASCII_BASE + 9,
+	[IDX(XK_Home)] = NONASCII_BASE + 10,
+	[IDX(XK_End)] = NONASCII_BASE + 11,
+};
+
+static uint8_t const function_keys[256] = {
+	[IDX(XK_Control_L)] = NONASCII_BASE + 0,
+	[IDX(XK_Shift_L)] = NONASCII_BASE + 1,
+	[IDX(XK_Alt_L)] = NONASCII_BASE + 2,
+	[IDX(XK_Super_L)] = NONASCII_BASE + 3,
+	[IDX(XK_Control_R)] = NONASCII_BASE + 4,
+	[IDX(XK_Shift_R)] = NONASCII_BASE + 5,
+	[IDX(XK_Alt_R)] = NONASCII_BASE + 6,
+	[IDX(XK_Super_R)] = NONASCII_BASE + 7,
+	[IDX(XK_Up)] = NONASCII_BASE + 8,
+	[IDX(XK_Down)] = NONASCII_BASE + 9,
+	[IDX(XK_Left)] = NONASCII_BASE + 10,
+	[IDX(XK_Right)] = NONASCII_BASE + 11,
+	[IDX(XK_BackSpace)] = NONASCII_BASE + 12,
+	[IDX(XK_Tab)] = NONASCII_BASE + 13,
+	[IDX(XK_Return)] = NONASCII_BASE + 14,
+	[IDX(XK_Escape)] = NONASCII_BASE + 15,
+	[IDX(XK_Print)] = NONASCII_BASE + 17,
+	[IDX(XK_Caps_Lock)] = NONASCII_BASE + 23,
+	[IDX(XK_F1)] = NONASCII_BASE + 24,
+	[IDX(XK_F2)] = NONASCII_BASE + 25,
+	[IDX(XK_F3)] = NONASCII_BASE + 26,
+	[IDX(XK_F4)] = NONASCII_BASE + 27,
+	[IDX(XK_F5)] = NONASCII_BASE + 28,
+	[IDX(XK_F6)] = NONASCII_BASE + 29,
+	[IDX(XK_F7)] = NONASCII_BASE + 30,
+	[IDX(XK_F8)] = NONASCII_BASE + 31,
+	[IDX(XK_F9)] = NONASCII_BASE + 32,
+	[IDX(XK_F10)] = NONASCII_BASE + 33,
+	[IDX(XK_F11)] = NONASCII_BASE + 34,
+	[IDX(XK_F12)] = NONASCII_BASE + 35,
+	[IDX(XK_F13)] = NONASCII_BASE + 36,
+	[IDX(XK_F14)] = NONASCII_BASE + 37,
+	[IDX(XK_F15)] = NONASCII_BASE + 38,
+	[IDX(XK_F16)] = NONASCII_BASE + 39,
+	[IDX(XK_F17)] = NONASCII_BASE + 40,
+	[IDX(XK_F18)] = NONASCII_BASE + 41,
+	[IDX(XK_F19)] = NONASCII_BASE + 42,
+	[IDX(XK_F20)] = NONASCII_BASE + 43,
+	[IDX(XK_F21)] = NONASCII_BASE + 44,
+	[IDX(XK_F22)] = NONASCII_BASE + 45,
+	[IDX(XK_F23)] = NONASCII_BASE + 46,
+	[IDX(XK_F24)] = NONASCII_BASE + 47,
+	[IDX(XK_KP_Insert)] = NONASCII_BASE + 48,
+	[IDX(XK_KP_0)] = NONASCII_BASE + 48,
+	[IDX(XK_KP_End)] = NONASCII_BASE + 49,
+	[IDX(XK_KP_1)] = NONASCII_BASE + 49,
+	[IDX(XK_KP_Down)] = NONASCII_BASE + 50,
+	[IDX(XK_KP_2)] = NONASCII_BASE + 50,
+	[IDX(XK_KP_Page_Down)] = NONASCII_BASE + 51,
+	[IDX(XK_KP_3)] = NONASCII_BASE + 51,
+	[IDX(XK_KP_Left)] = NONASCII_BASE + 52,
+	[IDX(XK_KP_4)] = NONASCII_BASE + 52,
+	[IDX(XK_KP_Begin)] = NONASCII_BASE + 53,
+	[IDX(XK_KP_5)] = NONASCII_BASE + 53,
+	[IDX(XK_KP_Right)] = NONASCII_BASE + 54,
+	[IDX(XK_KP_6)] = NONASCII_BASE + 54,
+	[IDX(XK_KP_Home)] = NONASCII_BASE + 55,
+	[IDX(XK_KP_7)] = NONASCII_BASE + 55,
+	[IDX(XK_KP_Up)] = NONASCII_BASE + 56,
+	[IDX(XK_KP_8)] = NONASCII_BASE + 56,
+	[IDX(XK_KP_Page_Up)] = NONASCII_BASE + 57,
+	[IDX(XK_KP_9)] = NONASCII_BASE + 57,
+	[IDX(XK_KP_Divide)] = NONASCII_BASE + 58,
+	[IDX(XK_KP_Multiply)] = NONASCII_BASE + 59,
+	[IDX(XK_KP_Subtract)] = NONASCII_BASE + 60,
+	[IDX(XK_KP_Add)] = NONASCII_BASE + 61,
+	[IDX(XK_KP_Enter)] = NONASCII_BASE + 62,
+	[IDX(XK_KP_Delete)] = NONASCII_BASE + 63,
+	[IDX(XK_KP_Separator)] = NONASCII_BASE + 63,
+	[IDX(XK_Num_Lock)] = NONASCII_BASE + 64,
+	[IDX(XK_Insert)] = NONASCII_BASE + 16,
+	[IDX(XK_Delete)] = NONASCII_BASE + 18,
+	[IDX(XK_Page_Up)] = NONASCII_BASE + 19,
+	[IDX(XK_Page_Down)] = NONASCII_BASE + 20,
+	[IDX(XK_Home)] = NONASCII_BASE + 21,
+	[IDX(XK_End)] = NONASCII_BASE + 22,
+};
+
+// tables in use, zero entries fall through to the next table
+static uint8_t latin1_map[256] = { 0 };
+static uint8_t function_map[256] = { 0 };
+
+
+/* global functions */
+void keymap_init(void){
+	for(size_t i=0; i<256; i++){
+		latin1_map[i] = layout_keys[i];
+
+		if(latin1_map[i] == 0 && i >= 32 && i < 127)
+			latin1_map[i] = i;
+
+		function_map[i] = function_keys[i];
+
+		if(opts.reverse_custom_xkb_map && reverse_xkb_keys[i] != 0)
+			function_map[i] = reverse_xkb_keys[i];
+	}
+}
+
+uint8_t keymap_translate(KeySym sym){
+	switch(PAGE(sym)){
+	case 0x00:	return latin1_map[IDX(sym)];
+	case 0xff:	return function_map[IDX(sym)];
+	default:	return (sym == XK_ISO_Level3_Shift) ? NONASCII_BASE + 6 : 0;
+	}
+}
@@ -1,8 +1,10 @@
 #include <string.h>
 #include <controller/events.h>
+#include <controller/keymap.h>
 #include <controller/log.h>
 #include <controller/opts.h>
 #include <controller/render.h>
+#include <controller/trace.h>
 #include <controller/uart.h>
 #include <controller/xlib.h>
 
@@ -11,7 +13,8 @@
 int main(int argc, char **argv){
 	int r;
 	uart_t *uart;
-	xlib_obj_t *xobj;
+	xlib_obj_t *xobj = 0x0;
+	trace_t *trace = 0x0;
 	xevent_t ev;
 
 
@@ -20,32 +23,62 @@ int main(int argc, char **argv){
 	if(r != 0)
 		return r;
 
+	keymap_init();
+
 	uart = uart_init();
 
 	if(uart == 0x0)
 		goto err_0;
 
-	xobj = xlib_init("btmouseboard");
+	if(opts.record != 0x0 || opts.replay != 0x0){
+		trace = trace_open((opts.replay != 0x0) ? opts.replay : opts.record, (opts.replay != 0x0));
+
+		if(trace == 0x0)
+			goto err_1;
+	}
 
-	if(xobj == 0x0)
-		goto err_1;
+	if(!opts.no_x){
+		xobj = xlib_init("btmouseboard");
+
+		if(xobj == 0x0)
+			goto err_2;
+	}
+	else
+		opts.log_to_stdout = true;
 
 	// after initialising the log, log messages
 	// are shown in the window, instead of stdout
 	log_init(opts.debug);
 
-	while(xlib_event(xobj, &ev) == 0){
-		if(event_handle(&ev, xobj, uart) > 0)
-			break;
+	if(opts.replay != 0x0){
+		r = trace_replay(trace, opts.replay_speed, xobj, uart);
+	}
+	else{
+		while(xlib_event(xobj, &ev) == 0){
+			if(trace != 0x0)
+				trace_record(trace, &ev, xobj);
+
+			if(event_handle(&ev, xobj, uart) > 0)
+				break;
 
-		render(xobj, uart);
+			render(xobj, uart);
+		}
 	}
 
-	xlib_destroy(xobj);
+	if(xobj != 0x0)
+		xlib_destroy(xobj);
+
+	if(trace != 0x0)
+		trace_close(trace);
+
 	uart_destroy(uart);
 
-	return 0;
+	return (r < 0) ? 1 : 0;
+
 
+err_2:
+	if(trace != 0x0)
+		trace_close(trace);
 
 err_1:
 	uart_destroy(uart);
@@ -2,6 +2,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <controller/opts.h>
 
 
@@ -14,26 +15,47 @@ opts_t opts = {
 	.debug = false,
 	.log_to_stdout = false,
 	.reverse_custom_xkb_map = false,
+	.no_x = false,
+	.record = 0x0,
+	.replay = 0x0,
+	.replay_speed = 1.0,
 };
 
 
 /* global functions */
 int opts_parse(int argc, char **argv){
 	int opt;
+	char *end;
 	struct option const long_opt[] = {
 		{ .name = "debug",					.has_arg = no_argument,	.flag = 0x0,	.val = 'd' },
 		{ .name = "log-to-stdout",			.has_arg = no_argument,	.flag = 0x0,	.val = 's' },
 		{ .name = "reverse-xkb-custom-map",	.has_arg = no_argument,	.flag = 0x0,	.val = 'x' },
+		{ .name = "record",					.has_arg = required_argument,	.flag = 0x0,	.val = 'r' },
+		{ .name = "replay",					.has_arg = required_argument,	.flag = 0x0,	.val = 'p' },
+		{ .name = "replay-speed",			.has_arg = required_argument,	.flag = 0x0,	.val = 'a' },
+		{ .name = "no-x",					.has_arg = no_argument,	.flag = 0x0,	.val = 'n' },
 		{ .name = "help",					.has_arg = no_argument,	.flag = 0x0,	.val = 'h' },
 		{ 0, 0, 0, 0}
 	};
 
 
-	while((opt = getopt_long(argc, argv, ":dsxh", long_opt, 0)) != -1){
+	while((opt = getopt_long(argc, argv, ":dsxr:p:a:nh", long_opt, 0)) != -1){
 		switch(opt){
 		case 'd':	opts.debug = true; break;
 		case 's':	opts.log_to_stdout = true; break;
 		case 'x':	opts.reverse_custom_xkb_map = true; break;
+		case 'r':	opts.record = optarg; break;
+		case 'p':	opts.replay = optarg; break;
+		case 'n':	opts.no_x = true; break;
+
+		case 'a':
+			opts.replay_speed = strtod(optarg, &end);
+
+			if(*end != 0 || opts.replay_speed < 0)
+				return help(argv[0], "invalid replay speed \"%s\"\n\n", optarg);
+
+			break;
+
 		case 'h':	return help(argv[0], 0x0);
 
 		case ':':	return help(argv[0], "missing argument to \"%s\"\n\n", argv[optind - 1]);
@@ -45,6 +67,12 @@ int opts_parse(int argc, char **argv){
 	if(argc - optind > 0)
 		return help(argv[0], "too many arguments\n");
 
+	if(opts.record != 0x0 && opts.replay != 0x0)
+		return help(argv[0], "recording and replaying are mutually exclusive\n\n");
+
+	if(opts.no_x && opts.replay == 0x0)
+		return help(argv[0], "running without X requires a replay\n\n");
+
 	return 0;
 }
 
@@ -66,14 +94,22 @@ static int help(char const *prog_name, char const *err, ...){
 		"Grab the X11 keyboard and mouse and redirect their inputs to a btmouseboard usb or uart device.\n"
 		"\n"
 		"Options:\n"
-		"    %-20.20s    %s (default=%s)\n"
-		"    %-20.20s    %s (default=%s)\n"
-		"    %-20.20s    %s (default=%s)\n"
-		"    %-20.20s    %s\n"
+		"    %-30.30s    %s (default=%s)\n"
+		"    %-30.30s    %s (default=%s)\n"
+		"    %-30.30s    %s (default=%s)\n"
+		"    %-30.30s    %s\n"
+		"    %-30.30s    %s\n"
+		"    %-30.30s    %s (default=%s)\n"
+		"    %-30.30s    %s (default=%s)\n"
+		"    %-30.30s    %s\n"
 		, prog_name
 		, "-d, --debug", "enable debug output", "false"
 		, "-s, --log-to-stdout", "print log message to stdout rather than the application window", "false"
 		, "-x, --reverse-custom-xkb-map", "reverse the effects of the custom xkb map", "false"
+		, "-r, --record <file>", "record the input events to a trace file"
+		, "-p, --replay <file>", "replay the input events of a trace file"
+		, "-a, --replay-speed <factor>", "replay speed relative to the recording, 0 replays without delays", "1"
+		, "-n, --no-x", "replay straight to the uart, without X server", "false"
 		, "-h, --help", "print this help message"
 	);
 
@@ -0,0 +1,335 @@
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <X11/XKBlib.h>
+#include <controller/events.h>
+#include <controller/keymap.h>
+#include <controller/log.h>
+#include <controller/render.h>
+#include <controller/trace.h>
+#include <controller/uart.h>
+#include <controller/xlib.h>
+
+
+/* local/static prototypes */
+static int replay_x(trace_rec_t *rec, xlib_obj_t *xobj, uart_t *uart);
+static int replay_uart(trace_rec_t *rec, uart_t *uart);
+
+static int x_service(xlib_obj_t *xobj, uart_t *uart);
+static int x_wait(struct timespec *t, xlib_obj_t *xobj, uart_t *uart);
+static void advance(struct timespec *t, uint32_t dt, double speed);
+
+
+/* global functions */
+trace_t *trace_open(char const *file, bool replay){
+	trace_t *trace;
+	trace_hdr_t hdr;
+
+
+	trace = calloc(1, sizeof(trace_t));
+
+	if(trace == 0x0){
+		ERROR("allocating trace");
+
+		return 0x0;
+	}
+
+	trace->fp = fopen(file, replay ? "rb" : "wb");
+
+	if(trace->fp == 0x0){
+		ERROR("opening trace %s: %s", file, strerror(errno));
+		goto err;
+	}
+
+	if(replay){
+		if(fread(&hdr, sizeof(hdr), 1, trace->fp) != 1
+		|| memcmp(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic)) != 0
+		|| hdr.version != TRACE_VERSION
+		|| hdr.rec_size != sizeof(trace_rec_t)
+		){
+			ERROR("invalid trace %s", file);
+			goto err;
+		}
+	}
+	else{
+		memcpy(hdr.magic, TRACE_MAGIC, sizeof(hdr.magic));
+		hdr.version = TRACE_VERSION;
+		hdr.rec_size = sizeof(trace_rec_t);
+
+		if(fwrite(&hdr, sizeof(hdr), 1, trace->fp) != 1){
+			ERROR("writing trace %s: %s", file, strerror(errno));
+			goto err;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &trace->last);
+
+	return trace;
+
+
+err:
+	trace_close(trace);
+
+	return 0x0;
+}
+
+void trace_close(trace_t *trace){
+	if(trace->fp != 0x0)
+		fclose(trace->fp);
+
+	free(trace);
+}
+
+int trace_record(trace_t *trace, xevent_t *ev, xlib_obj_t *xobj){
+	trace_rec_t rec = { 0 };
+	struct timespec now;
+	int64_t dt;
+
+
+	rec.type = ev->type;
+
+	switch(ev->type){
+	case KeyPress:
+	case KeyRelease:
+		rec.code = ev->xkey.keycode;
+		rec.keysym = XkbKeycodeToKeysym(xobj->dpy, ev->xkey.keycode, 0, 0);
+		break;
+
+	case ButtonPress:
+	case ButtonRelease:
+		rec.code = ev->xbutton.button;
+		break;
+
+	case MotionNotify:
+		// same computation as the motion event handler
+		rec.dx = ev->xmotion.x - xobj->cursor_x;
+		rec.dy = ev->xmotion.y - xobj->cursor_y;
+		rec.x = ev->xmotion.x;
+		rec.y = ev->xmotion.y;
+		break;
+
+	case EnterNotify:
+		rec.x = ev->xcrossing.x;
+		rec.y = ev->xcrossing.y;
+		break;
+
+	case ConfigureNotify:
+		rec.x = ev->xconfigure.width;
+		rec.y = ev->xconfigure.height;
+		break;
+
+	default:
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	dt = (int64_t)(now.tv_sec - trace->last.tv_sec) * 1000000 + (now.tv_nsec - trace->last.tv_nsec) / 1000;
+	rec.dt = (dt > UINT32_MAX) ? UINT32_MAX : dt;
+	trace->last = now;
+
+	if(fwrite(&rec, sizeof(rec), 1, trace->fp) != 1)
+		return ERROR("writing trace: %s", strerror(errno));
+
+	return 0;
+}
+
+// Replay a trace at speed times its original pace, a speed of 0 replays
+// without delays. With an X server the events are fed through event_handle(),
+// otherwise (xobj = 0x0) the resulting commands are written straight to the uart.
+int trace_replay(trace_t *trace, double speed, xlib_obj_t *xobj, uart_t *uart){
+	int r = 0;
+	trace_rec_t rec;
+	struct timespec t;
+	size_t n = 0;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	while(fread(&rec, sizeof(rec), 1, trace->fp) == 1){
+		advance(&t, rec.dt, speed);
+
+		if(xobj != 0x0){
+			// stop if the window is closed or the X connection is lost,
+			// errors of individual events are ignored like in the event loop
+			r = x_wait((speed > 0) ? &t : 0x0, xobj, uart);
+
+			if(r != 0 || replay_x(&rec, xobj, uart) > 0)
+				break;
+		}
+		else{
+			if(speed > 0)
+				clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, 0x0);
+
+			r = replay_uart(&rec, uart);
+
+			if(r < 0){
+				ERROR("replay aborted after %zu events", n);
+				break;
+			}
+		}
+
+		n++;
+	}
+
+	if(ferror(trace->fp))
+		return ERROR("reading trace: %s", strerror(errno));
+
+	INFO("replayed %zu events", n);
+
+	return (r < 0) ? r : 0;
+}
+
+
+/* local functions */
+static int replay_x(trace_rec_t *rec, xlib_obj_t *xobj, uart_t *uart){
+	xevent_t ev;
+	int r;
+
+
+	memset(&ev, 0, sizeof(ev));
+	ev.type = rec->type;
+
+	switch(rec->type){
+	case KeyPress:
+	case KeyRelease:
+		ev.xkey.keycode = rec->code;
+		break;
+
+	case ButtonPress:
+	case ButtonRelease:
+		ev.xbutton.button = rec->code;
+		break;
+
+	case MotionNotify:
+		ev.xmotion.x = rec->x;
+		ev.xmotion.y = rec->y;
+		break;
+
+	case EnterNotify:
+		ev.xcrossing.x = rec->x;
+		ev.xcrossing.y = rec->y;
+		break;
+
+	case ConfigureNotify:
+		ev.xconfigure.width = rec->x;
+		ev.xconfigure.height = rec->y;
+		break;
+
+	default:
+		return ERROR("invalid trace event type %u", rec->type);
+	}
+
+	r = event_handle(&ev, xobj, uart);
+	render(xobj, uart);
+
+	return r;
+}
+
+static int replay_uart(trace_rec_t *rec, uart_t *uart){
+	uint8_t key;
+
+
+	switch(rec->type){
+	case KeyPress:
+	case KeyRelease:
+		key = keymap_translate(rec->keysym);
+
+		// not a uart failure, hence do not abort the replay
+		if(key == 0){
+			ERROR("unsupported key: keysym=%s", XKeysymToString(rec->keysym));
+			return 0;
+		}
+
+		return uart_key(uart, key, (rec->type == KeyPress));
+
+	case ButtonPress:
+	case ButtonRelease:
+		return uart_button(uart, rec->code, (rec->type == ButtonPress));
+
+	case MotionNotify:
+		return uart_move(uart, rec->dx, rec->dy);
+
+	case EnterNotify:
+	case ConfigureNotify:
+		return 0;
+
+	default:
+		return ERROR("invalid trace event type %u", rec->type);
+	}
+}
+
+// Handle the events pending on the real X connection. Input events are
+// dropped, they would interfere with the replayed ones, e.g. the motion
+// events caused by warping the pointer.
+static int x_service(xlib_obj_t *xobj, uart_t *uart){
+	int r;
+	xevent_t ev;
+
+
+	while(XPending(xobj->dpy)){
+		if(xlib_event(xobj, &ev) != 0)
+			return -1;
+
+		switch(ev.type){
+		case KeyPress:
+		case KeyRelease:
+		case ButtonPress:
+		case ButtonRelease:
+		case MotionNotify:
+		case EnterNotify:
+			continue;
+		}
+
+		r = event_handle(&ev, xobj, uart);
+		render(xobj, uart);
+
+		if(r > 0)
+			return r;
+	}
+
+	return 0;
+}
+
+// Service the X connection until t is reached, or only once if t is 0x0.
+static int x_wait(struct timespec *t, xlib_obj_t *xobj, uart_t *uart){
+	int r;
+	int64_t ms;
+	struct timespec now;
+	struct pollfd pfd = { .fd = ConnectionNumber(xobj->dpy), .events = POLLIN };
+
+
+	while(1){
+		r = x_service(xobj, uart);
+
+		if(r != 0 || t == 0x0)
+			return r;
+
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		ms = (int64_t)(t->tv_sec - now.tv_sec) * 1000 + (t->tv_nsec - now.tv_nsec) / 1000000;
+
+		if(ms <= 0)
+			break;
+
+		poll(&pfd, 1, ms);
+	}
+
+	// sleep the sub-millisecond remainder
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, t, 0x0);
+
+	return 0;
+}
+
+static void advance(struct timespec *t, uint32_t dt, double speed){
+	uint64_t ns;
+
+
+	if(speed <= 0)
+		return;
+
+	ns = t->tv_nsec + (uint64_t)(dt * 1000.0 / speed);
+	t->tv_sec += ns / 1000000000;
+	t->tv_nsec = ns % 1000000000;
+}
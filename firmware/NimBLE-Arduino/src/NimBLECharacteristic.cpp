@@ -499,7 +499,7 @@ void NimBLECharacteristic::notify(const uint8_t* value, size_t length, bool is_n
         // don't create the m_buf until we are sure to send the data or else
         // we could be allocating a buffer that doesn't get released.
         // We also must create it in each loop iteration because it is consumed with each host call.
-        os_mbuf *om = ble_hs_mbuf_from_flat(value, length);
+        os_mbuf *om = ble_hs_mbuf_att_value_from_flat(value, length);
 
         if(!is_notification && (m_properties & NIMBLE_PROPERTY::INDICATE)) {
             if(!NimBLEDevice::getServer()->setIndicateWait(it.first)) {
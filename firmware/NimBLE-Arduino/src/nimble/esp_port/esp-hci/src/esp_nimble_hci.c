@@ -105,6 +105,7 @@ int ble_hci_trans_hs_acl_tx(struct os_mbuf *om)
 {
     uint16_t len = 0;
     uint8_t data[MYNEWT_VAL(BLE_ACL_BUF_SIZE) + 3], rc = 0;
+    uint8_t *pkt;
 
     /* If this packet is zero length, just free it */
     if (OS_MBUF_PKTLEN(om) == 0) {
@@ -117,11 +118,21 @@ int ble_hci_trans_hs_acl_tx(struct os_mbuf *om)
     }
 
     len = 1 + OS_MBUF_PKTLEN(om);
-    data[0] = BLE_HCI_UART_H4_ACL;
-    os_mbuf_copydata(om, 0, OS_MBUF_PKTLEN(om), &data[1]);
+
+    /* Packets built with enough leading space, e.g. notifications, are sent
+     * straight from the mbuf; only chains need to be flattened.
+     */
+    if (SLIST_NEXT(om, om_next) == NULL && OS_MBUF_LEADINGSPACE(om) > 0) {
+        pkt = om->om_data - 1;
+    } else {
+        pkt = data;
+        os_mbuf_copydata(om, 0, OS_MBUF_PKTLEN(om), &data[1]);
+    }
+
+    pkt[0] = BLE_HCI_UART_H4_ACL;
 
     if (xSemaphoreTake(vhci_send_sem, NIMBLE_VHCI_TIMEOUT_MS / portTICK_PERIOD_MS) == pdTRUE) {
-        esp_vhci_host_send_packet(data, len);
+        esp_vhci_host_send_packet(pkt, len);
     } else {
         rc = BLE_HS_ETIMEOUT_HCI;
     }
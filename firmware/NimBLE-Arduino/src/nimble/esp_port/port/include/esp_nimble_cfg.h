@@ -37,6 +37,10 @@
 #define MYNEWT_VAL_MSYS_2_BLOCK_SIZE (0)
 #endif
 
+#ifndef MYNEWT_VAL_OS_MEMPOOL_LOCKFREE
+#define MYNEWT_VAL_OS_MEMPOOL_LOCKFREE (CONFIG_BT_NIMBLE_MEMPOOL_LOCKFREE)
+#endif
+
 #ifndef MYNEWT_VAL_OS_CPUTIME_FREQ
 #define MYNEWT_VAL_OS_CPUTIME_FREQ (1000000)
 #endif
@@ -226,10 +230,18 @@
 #define MYNEWT_VAL_BLE_LL_RESOLV_LIST_SIZE (4)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_RESOLV_RPA_CACHE_SIZE
+#define MYNEWT_VAL_BLE_LL_RESOLV_RPA_CACHE_SIZE (4)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_RNG_BUFSIZE
 #define MYNEWT_VAL_BLE_LL_RNG_BUFSIZE (32)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_LL_CONN_DRAIN_TXQ
+#define MYNEWT_VAL_BLE_LL_CONN_DRAIN_TXQ (0)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_LL_STRICT_CONN_SCHEDULING
 #define MYNEWT_VAL_BLE_LL_STRICT_CONN_SCHEDULING (0)
 #endif
@@ -303,6 +315,10 @@
 #define MYNEWT_VAL_BLE_VERSION (50)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_ATT_SVR_DISC_CACHE_CNT
+#define MYNEWT_VAL_BLE_ATT_SVR_DISC_CACHE_CNT (CONFIG_BT_NIMBLE_ATT_DISC_CACHE_COUNT)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_ATT_SVR_FIND_INFO
 #define MYNEWT_VAL_BLE_ATT_SVR_FIND_INFO (1)
 #endif
@@ -363,6 +379,10 @@
 #define MYNEWT_VAL_BLE_ATT_SVR_WRITE_NO_RSP (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_GAP_CONN_EVENT_HOOK
+#define MYNEWT_VAL_BLE_GAP_CONN_EVENT_HOOK (CONFIG_BT_NIMBLE_CONN_EVENT_HOOK)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE
 #define MYNEWT_VAL_BLE_GAP_MAX_PENDING_CONN_PARAM_UPDATE (1)
 #endif
@@ -403,6 +423,10 @@
 #define MYNEWT_VAL_BLE_GATT_NOTIFY (1)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_GATTS_TX_POLICY_CNT
+#define MYNEWT_VAL_BLE_GATTS_TX_POLICY_CNT (CONFIG_BT_NIMBLE_GATTS_TX_POLICY_COUNT)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_GATT_READ
 #define MYNEWT_VAL_BLE_GATT_READ (MYNEWT_VAL_BLE_ROLE_CENTRAL)
 #endif
@@ -475,6 +499,10 @@
 #endif
 #endif
 
+#ifndef MYNEWT_VAL_BLE_SM_SC_KEY_POOL_CNT
+#define MYNEWT_VAL_BLE_SM_SC_KEY_POOL_CNT (CONFIG_BT_NIMBLE_SM_SC_KEY_POOL_COUNT)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_SM_SC_DEBUG_KEYS
 #ifdef CONFIG_BT_NIMBLE_SM_SC_DEBUG_KEYS
 #define MYNEWT_VAL_BLE_SM_SC_DEBUG_KEYS (1)
@@ -495,6 +523,10 @@
 #endif
 #endif
 
+#ifndef MYNEWT_VAL_BLE_HS_HCI_EVT_BATCH
+#define MYNEWT_VAL_BLE_HS_HCI_EVT_BATCH (CONFIG_BT_NIMBLE_HCI_EVT_BATCH)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_HS_FLOW_CTRL_ITVL
 #define MYNEWT_VAL_BLE_HS_FLOW_CTRL_ITVL CONFIG_BT_NIMBLE_HS_FLOW_CTRL_ITVL
 #endif
@@ -986,6 +1018,10 @@
 #define MYNEWT_VAL_BLE_MESH_MSG_CACHE_SIZE (10)
 #endif
 
+#ifndef MYNEWT_VAL_BLE_MESH_KEY_SCHED_CACHE_SIZE
+#define MYNEWT_VAL_BLE_MESH_KEY_SCHED_CACHE_SIZE (CONFIG_BT_NIMBLE_MESH_KEY_SCHED_CACHE_SIZE)
+#endif
+
 #ifndef MYNEWT_VAL_BLE_MESH_NET_LOG_LVL
 #define MYNEWT_VAL_BLE_MESH_NET_LOG_LVL (1)
 #endif
@@ -291,6 +291,52 @@ static void uECC_vli_mult(uECC_word_t *result, const uECC_word_t *left,
 	result[num_words * 2 - 1] = r0;
 }
 
+static void mul2add(uECC_word_t a, uECC_word_t b, uECC_word_t *r0,
+		    uECC_word_t *r1, uECC_word_t *r2)
+{
+
+	uECC_dword_t p = (uECC_dword_t)a * b;
+	uECC_dword_t r01 = ((uECC_dword_t)(*r1) << uECC_WORD_BITS) | *r0;
+	*r2 += (p >> (uECC_WORD_BITS * 2 - 1));
+	p *= 2;
+	r01 += p;
+	*r2 += (r01 < p);
+	*r1 = r01 >> uECC_WORD_BITS;
+	*r0 = (uECC_word_t)r01;
+
+}
+
+/* Computes result = left^2 for NUM_ECC_WORDS words. Result must be
+ * 2 * NUM_ECC_WORDS long. Each cross product is computed once and doubled,
+ * which saves 28 of the 64 word multiplications of uECC_vli_mult(). */
+static void vli_square_p256(uECC_word_t *result, const uECC_word_t *left)
+{
+
+	uECC_word_t r0 = 0;
+	uECC_word_t r1 = 0;
+	uECC_word_t r2 = 0;
+	wordcount_t i, k;
+
+	for (k = 0; k < NUM_ECC_WORDS * 2 - 1; ++k) {
+
+		i = (k < NUM_ECC_WORDS) ? 0 : (k + 1) - NUM_ECC_WORDS;
+
+		for (; i < k - i; ++i) {
+			mul2add(left[i], left[k - i], &r0, &r1, &r2);
+		}
+
+		if (i == k - i) {
+			muladd(left[i], left[i], &r0, &r1, &r2);
+		}
+
+		result[k] = r0;
+		r0 = r1;
+		r1 = r2;
+		r2 = 0;
+	}
+	result[NUM_ECC_WORDS * 2 - 1] = r0;
+}
+
 void uECC_vli_modAdd(uECC_word_t *result, const uECC_word_t *left,
 		     const uECC_word_t *right, const uECC_word_t *mod,
 		     wordcount_t num_words)
@@ -370,20 +416,32 @@ void uECC_vli_modMult(uECC_word_t *result, const uECC_word_t *left,
 	uECC_vli_mmod(result, product, mod, num_words);
 }
 
+static void vli_mmod_fast_p256(uECC_word_t *result, const uECC_word_t *product);
+
+/* secp256r1 is the only curve tinycrypt provides, so the multiplication and
+ * reduction below are fixed to its size instead of going through
+ * curve->num_words and curve->mmod_fast. */
 void uECC_vli_modMult_fast(uECC_word_t *result, const uECC_word_t *left,
 			   const uECC_word_t *right, uECC_Curve curve)
 {
 	uECC_word_t product[2 * NUM_ECC_WORDS];
-	uECC_vli_mult(product, left, right, curve->num_words);
 
-	curve->mmod_fast(result, product);
+	(void)curve;
+	uECC_vli_mult(product, left, right, NUM_ECC_WORDS);
+
+	vli_mmod_fast_p256(result, product);
 }
 
 static void uECC_vli_modSquare_fast(uECC_word_t *result,
 				    const uECC_word_t *left,
 				    uECC_Curve curve)
 {
-	uECC_vli_modMult_fast(result, left, left, curve);
+	uECC_word_t product[2 * NUM_ECC_WORDS];
+
+	(void)curve;
+	vli_square_p256(product, left);
+
+	vli_mmod_fast_p256(result, product);
 }
 
 
@@ -518,93 +576,49 @@ uECC_Curve uECC_secp256r1(void)
 	return &curve_secp256r1;
 }
 
-void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int*product)
+/*
+ * Solinas reduction: the T + 2S1 + 2S2 + S3 + S4 - D1 - D2 - D3 - D4 terms from
+ * the NIST routines are summed column by column into a signed 64-bit
+ * accumulator, so the product is walked once instead of once per term.
+ */
+#define c(i) ((int64_t)product[i])
+
+static void vli_mmod_fast_p256(uECC_word_t *result, const uECC_word_t *product)
 {
-	unsigned int tmp[NUM_ECC_WORDS];
+	int64_t acc;
 	int carry;
 
-	/* t */
-	uECC_vli_set(result, product, NUM_ECC_WORDS);
-
-	/* s1 */
-	tmp[0] = tmp[1] = tmp[2] = 0;
-	tmp[3] = product[11];
-	tmp[4] = product[12];
-	tmp[5] = product[13];
-	tmp[6] = product[14];
-	tmp[7] = product[15];
-	carry = uECC_vli_add(tmp, tmp, tmp, NUM_ECC_WORDS);
-	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
-
-	/* s2 */
-	tmp[3] = product[12];
-	tmp[4] = product[13];
-	tmp[5] = product[14];
-	tmp[6] = product[15];
-	tmp[7] = 0;
-	carry += uECC_vli_add(tmp, tmp, tmp, NUM_ECC_WORDS);
-	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
-
-	/* s3 */
-	tmp[0] = product[8];
-	tmp[1] = product[9];
-	tmp[2] = product[10];
-	tmp[3] = tmp[4] = tmp[5] = 0;
-	tmp[6] = product[14];
-	tmp[7] = product[15];
-  	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
-
-	/* s4 */
-	tmp[0] = product[9];
-	tmp[1] = product[10];
-	tmp[2] = product[11];
-	tmp[3] = product[13];
-	tmp[4] = product[14];
-	tmp[5] = product[15];
-	tmp[6] = product[13];
-	tmp[7] = product[8];
-	carry += uECC_vli_add(result, result, tmp, NUM_ECC_WORDS);
-
-	/* d1 */
-	tmp[0] = product[11];
-	tmp[1] = product[12];
-	tmp[2] = product[13];
-	tmp[3] = tmp[4] = tmp[5] = 0;
-	tmp[6] = product[8];
-	tmp[7] = product[10];
-	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
-
-	/* d2 */
-	tmp[0] = product[12];
-	tmp[1] = product[13];
-	tmp[2] = product[14];
-	tmp[3] = product[15];
-	tmp[4] = tmp[5] = 0;
-	tmp[6] = product[9];
-	tmp[7] = product[11];
-	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
-
-	/* d3 */
-	tmp[0] = product[13];
-	tmp[1] = product[14];
-	tmp[2] = product[15];
-	tmp[3] = product[8];
-	tmp[4] = product[9];
-	tmp[5] = product[10];
-	tmp[6] = 0;
-	tmp[7] = product[12];
-	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
-
-	/* d4 */
-	tmp[0] = product[14];
-	tmp[1] = product[15];
-	tmp[2] = 0;
-	tmp[3] = product[9];
-	tmp[4] = product[10];
-	tmp[5] = product[11];
-	tmp[6] = 0;
-	tmp[7] = product[13];
-	carry -= uECC_vli_sub(result, result, tmp, NUM_ECC_WORDS);
+	acc = c(0) + c(8) + c(9) - c(11) - c(12) - c(13) - c(14);
+	result[0] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(1) + c(9) + c(10) - c(12) - c(13) - c(14) - c(15);
+	result[1] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(2) + c(10) + c(11) - c(13) - c(14) - c(15);
+	result[2] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(3) + 2 * (c(11) + c(12)) + c(13) - c(15) - c(8) - c(9);
+	result[3] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(4) + 2 * (c(12) + c(13)) + c(14) - c(9) - c(10);
+	result[4] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(5) + 2 * (c(13) + c(14)) + c(15) - c(10) - c(11);
+	result[5] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(6) + 3 * c(14) + 2 * c(15) + c(13) - c(8) - c(9);
+	result[6] = (uECC_word_t)acc;
+	acc >>= uECC_WORD_BITS;
+
+	acc += c(7) + 3 * c(15) + c(8) - c(10) - c(11) - c(12) - c(13);
+	result[7] = (uECC_word_t)acc;
+	carry = (int)(acc >> uECC_WORD_BITS);
 
 	if (carry < 0) {
 		do {
@@ -619,6 +633,13 @@ void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int*product)
 	}
 }
 
+#undef c
+
+void vli_mmod_fast_secp256r1(unsigned int *result, unsigned int*product)
+{
+	vli_mmod_fast_p256(result, product);
+}
+
 uECC_word_t EccPoint_isZero(const uECC_word_t *point, uECC_Curve curve)
 {
 	return uECC_vli_isZero(point, curve->num_words * 2);
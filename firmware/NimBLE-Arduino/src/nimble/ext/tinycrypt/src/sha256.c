@@ -72,13 +72,39 @@ int tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen)
 		return TC_CRYPTO_SUCCESS;
 	}
 
-	while (datalen-- > 0) {
-		s->leftover[s->leftover_offset++] = *(data++);
-		if (s->leftover_offset >= TC_SHA256_BLOCK_SIZE) {
-			compress(s->iv, s->leftover);
-			s->leftover_offset = 0;
-			s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
+	/* top up a partially filled block first */
+	if (s->leftover_offset > 0) {
+		size_t n = TC_SHA256_BLOCK_SIZE - s->leftover_offset;
+
+		if (n > datalen) {
+			n = datalen;
+		}
+
+		(void)_copy(s->leftover + s->leftover_offset, n, data, n);
+		s->leftover_offset += n;
+		data += n;
+		datalen -= n;
+
+		if (s->leftover_offset < TC_SHA256_BLOCK_SIZE) {
+			return TC_CRYPTO_SUCCESS;
 		}
+
+		compress(s->iv, s->leftover);
+		s->leftover_offset = 0;
+		s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
+	}
+
+	/* whole blocks are compressed straight from the input */
+	while (datalen >= TC_SHA256_BLOCK_SIZE) {
+		compress(s->iv, data);
+		s->bits_hashed += (TC_SHA256_BLOCK_SIZE << 3);
+		data += TC_SHA256_BLOCK_SIZE;
+		datalen -= TC_SHA256_BLOCK_SIZE;
+	}
+
+	if (datalen > 0) {
+		(void)_copy(s->leftover, datalen, data, datalen);
+		s->leftover_offset = datalen;
 	}
 
 	return TC_CRYPTO_SUCCESS;
@@ -178,38 +204,48 @@ static inline unsigned int BigEndian(const uint8_t **c)
 	return n;
 }
 
+/*
+ * One round with the working variables passed in rotated order instead of
+ * shifted through h..a, so eight consecutive rounds need no register moves.
+ */
+#define ROUND(a, b, c, d, e, f, g, h, W, i) do {			\
+		unsigned int t1 = (h) + Sigma1(e) + Ch(e, f, g) + k256[i] + W(i); \
+		(d) += t1;						\
+		(h) = t1 + Sigma0(a) + Maj(a, b, c);			\
+	} while (0)
+
+#define SCHEDULE(w, i)(w[(i)&0x0f] += sigma0(w[((i)+1)&0x0f]) +	\
+		       sigma1(w[((i)+14)&0x0f]) + w[((i)+9)&0x0f])
+
+#define ROUNDS_8(W, i) do {						\
+		ROUND(a, b, c, d, e, f, g, h, W, (i));			\
+		ROUND(h, a, b, c, d, e, f, g, W, (i)+1);		\
+		ROUND(g, h, a, b, c, d, e, f, W, (i)+2);		\
+		ROUND(f, g, h, a, b, c, d, e, W, (i)+3);		\
+		ROUND(e, f, g, h, a, b, c, d, W, (i)+4);		\
+		ROUND(d, e, f, g, h, a, b, c, W, (i)+5);		\
+		ROUND(c, d, e, f, g, h, a, b, W, (i)+6);		\
+		ROUND(b, c, d, e, f, g, h, a, W, (i)+7);		\
+	} while (0)
+
+#define W_LOAD(i)(work_space[i] = BigEndian(&data))
+#define W_NEXT(i)(SCHEDULE(work_space, i))
+
 static void compress(unsigned int *iv, const uint8_t *data)
 {
 	unsigned int a, b, c, d, e, f, g, h;
-	unsigned int s0, s1;
-	unsigned int t1, t2;
 	unsigned int work_space[16];
-	unsigned int n;
 	unsigned int i;
 
 	a = iv[0]; b = iv[1]; c = iv[2]; d = iv[3];
 	e = iv[4]; f = iv[5]; g = iv[6]; h = iv[7];
 
-	for (i = 0; i < 16; ++i) {
-		n = BigEndian(&data);
-		t1 = work_space[i] = n;
-		t1 += h + Sigma1(e) + Ch(e, f, g) + k256[i];
-		t2 = Sigma0(a) + Maj(a, b, c);
-		h = g; g = f; f = e; e = d + t1;
-		d = c; c = b; b = a; a = t1 + t2;
+	for (i = 0; i < 16; i += 8) {
+		ROUNDS_8(W_LOAD, i);
 	}
 
-	for ( ; i < 64; ++i) {
-		s0 = work_space[(i+1)&0x0f];
-		s0 = sigma0(s0);
-		s1 = work_space[(i+14)&0x0f];
-		s1 = sigma1(s1);
-
-		t1 = work_space[i&0xf] += s0 + s1 + work_space[(i+9)&0xf];
-		t1 += h + Sigma1(e) + Ch(e, f, g) + k256[i];
-		t2 = Sigma0(a) + Maj(a, b, c);
-		h = g; g = f; f = e; e = d + t1;
-		d = c; c = b; b = a; a = t1 + t2;
+	for ( ; i < 64; i += 8) {
+		ROUNDS_8(W_NEXT, i);
 	}
 
 	iv[0] += a; iv[1] += b; iv[2] += c; iv[3] += d;
@@ -272,6 +272,7 @@ struct ble_ll_conn_sm
     uint8_t last_rxd_sn;        /* note: cant be 1 bit given current code */
     uint8_t last_rxd_hdr_byte;  /* note: possibly can make 1 bit since we
                                    only use the MD bit now */
+    uint8_t ce_txd_pkts;        /* l2cap pdus completed in current event */
 
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_CTRL_TO_HOST_FLOW_CONTROL)
     uint16_t cth_flow_pending;
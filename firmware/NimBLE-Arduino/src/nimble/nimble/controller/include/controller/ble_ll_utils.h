@@ -27,3 +27,4 @@ uint8_t ble_ll_utils_calc_num_used_chans(const uint8_t *chanmap);
 uint32_t ble_ll_utils_calc_window_widening(uint32_t anchor_point,
                                            uint32_t last_anchor_point,
                                            uint8_t master_sca);
+uint32_t ble_ll_utils_addr_hash(const uint8_t *addr, uint8_t addr_type);
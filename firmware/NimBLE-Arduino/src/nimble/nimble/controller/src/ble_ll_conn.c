@@ -203,6 +203,9 @@ STATS_SECT_START(ble_ll_conn_stats)
     STATS_SECT_ENTRY(sched_start_in_idle)
     STATS_SECT_ENTRY(sched_end_in_idle)
     STATS_SECT_ENTRY(conn_event_while_tmo)
+    STATS_SECT_ENTRY(ce_with_tx)
+    STATS_SECT_ENTRY(ce_multi_tx)
+    STATS_SECT_ENTRY(ce_tx_pkts)
 STATS_SECT_END
 STATS_SECT_DECL(ble_ll_conn_stats) ble_ll_conn_stats;
 
@@ -236,6 +239,9 @@ STATS_NAME_START(ble_ll_conn_stats)
     STATS_NAME(ble_ll_conn_stats, sched_start_in_idle)
     STATS_NAME(ble_ll_conn_stats, sched_end_in_idle)
     STATS_NAME(ble_ll_conn_stats, conn_event_while_tmo)
+    STATS_NAME(ble_ll_conn_stats, ce_with_tx)
+    STATS_NAME(ble_ll_conn_stats, ce_multi_tx)
+    STATS_NAME(ble_ll_conn_stats, ce_tx_pkts)
 STATS_NAME_END(ble_ll_conn_stats)
 
 static void ble_ll_conn_event_end(struct ble_npl_event *ev);
@@ -864,6 +870,52 @@ ble_ll_conn_get_next_sched_time(struct ble_ll_conn_sm *connsm)
     return ce_end;
 }
 
+/**
+ * Returns the air time to reserve for the peer's response when deciding
+ * whether another PDU fits into the connection event.
+ *
+ * By default a maximum sized response is assumed.  With
+ * BLE_LL_CONN_DRAIN_TXQ an empty response is assumed while the peer has not
+ * signalled more data, but only if the event is bounded by the start of this
+ * connection's own next event.  The peer's last MD bit does not bound its
+ * next reply, it may still answer with up to eff_max_rx_time, so the full
+ * reservation is kept whenever another scheduled item could be overrun.
+ *
+ * Context: Interrupt
+ *
+ * @param connsm
+ * @param next_sched_time The end of the connection event, as returned by
+ *                        ble_ll_conn_get_next_sched_time().
+ *
+ * @return uint32_t Response time in usecs.
+ */
+static uint32_t
+ble_ll_conn_peer_rsp_usecs(struct ble_ll_conn_sm *connsm,
+                           uint32_t next_sched_time)
+{
+#if MYNEWT_VAL(BLE_LL_CONN_DRAIN_TXQ) && \
+    !MYNEWT_VAL(BLE_LL_STRICT_CONN_SCHEDULING)
+    int rx_phy_mode;
+    uint32_t sched_time;
+
+    if (ble_ll_sched_next_time(&sched_time) &&
+        !CPUTIME_GT(sched_time, next_sched_time)) {
+        return connsm->eff_max_rx_time;
+    }
+
+    if ((connsm->last_rxd_hdr_byte & BLE_LL_DATA_HDR_MD_MASK) == 0) {
+#if BLE_LL_BT5_PHY_SUPPORTED
+        rx_phy_mode = connsm->phy_data.rx_phy_mode;
+#else
+        rx_phy_mode = BLE_PHY_MODE_1M;
+#endif
+        return ble_ll_pdu_tx_time_get(0, rx_phy_mode);
+    }
+#endif
+
+    return connsm->eff_max_rx_time;
+}
+
 /**
  * Called to check if certain connection state machine flags have been
  * set.
@@ -1163,12 +1215,14 @@ ble_ll_conn_tx_pdu(struct ble_ll_conn_sm *connsm)
         tx_phy_mode = BLE_PHY_MODE_1M;
 #endif
 
-        ticks = (BLE_LL_IFS * 3) + connsm->eff_max_rx_time +
+        ticks = (BLE_LL_IFS * 3) +
+            ble_ll_conn_peer_rsp_usecs(connsm, next_event_time) +
             ble_ll_pdu_tx_time_get(next_txlen, tx_phy_mode) +
             ble_ll_pdu_tx_time_get(cur_txlen, tx_phy_mode);
 
         if (connsm->conn_role == BLE_LL_CONN_ROLE_MASTER) {
-            ticks += (BLE_LL_IFS + connsm->eff_max_rx_time);
+            ticks += (BLE_LL_IFS +
+                      ble_ll_conn_peer_rsp_usecs(connsm, next_event_time));
         }
 
         ticks = os_cputime_usecs_to_ticks(ticks);
@@ -1550,7 +1604,8 @@ ble_ll_conn_can_send_next_pdu(struct ble_ll_conn_sm *connsm, uint32_t begtime,
             /* We will send empty pdu (just a LL header) */
             usecs = ble_ll_pdu_tx_time_get(0, tx_phy_mode);
         }
-        usecs += (BLE_LL_IFS * 2) + connsm->eff_max_rx_time;
+        usecs += (BLE_LL_IFS * 2) +
+                 ble_ll_conn_peer_rsp_usecs(connsm, next_sched_time);
 
         ticks = (uint32_t)(next_sched_time - begtime);
         allowed_usecs = os_cputime_ticks_to_usecs(ticks);
@@ -1911,6 +1966,7 @@ ble_ll_conn_sm_new(struct ble_ll_conn_sm *connsm)
     connsm->cons_rxd_bad_crc = 0;
     connsm->last_rxd_sn = 1;
     connsm->completed_pkts = 0;
+    connsm->ce_txd_pkts = 0;
 
     /* initialize data length mgmt */
     conn_params = &g_ble_ll_conn_params;
@@ -2632,6 +2688,15 @@ ble_ll_conn_event_end(struct ble_npl_event *ev)
     connsm->cons_rxd_bad_crc = 0;
     connsm->csmflags.cfbit.pkt_rxd = 0;
 
+    if (connsm->ce_txd_pkts) {
+        STATS_INC(ble_ll_conn_stats, ce_with_tx);
+        STATS_INCN(ble_ll_conn_stats, ce_tx_pkts, connsm->ce_txd_pkts);
+        if (connsm->ce_txd_pkts > 1) {
+            STATS_INC(ble_ll_conn_stats, ce_multi_tx);
+        }
+        connsm->ce_txd_pkts = 0;
+    }
+
     /* See if we need to start any control procedures */
     ble_ll_ctrl_chk_proc_start(connsm);
 
@@ -4003,6 +4068,7 @@ ble_ll_conn_rx_isr_end(uint8_t *rxbuf, struct ble_mbuf_hdr *rxhdr)
                             bletest_completed_pkt(connsm->conn_handle);
 #endif
                             ++connsm->completed_pkts;
+                            ++connsm->ce_txd_pkts;
                             if (connsm->completed_pkts > 2) {
                                 ble_npl_eventq_put(&g_ble_ll_data.ll_evq,
                                                    &g_ble_ll_data.ll_comp_pkt_ev);
@@ -32,6 +32,7 @@
 #include "../include/controller/ble_ll_adv.h"
 #include "../include/controller/ble_ll_sync.h"
 #include "../include/controller/ble_hw.h"
+#include "../include/controller/ble_ll_utils.h"
 #include "ble_ll_conn_priv.h"
 
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_PRIVACY)
@@ -49,6 +50,124 @@ struct ble_ll_resolv_data g_ble_ll_resolv_data;
 __attribute__((aligned(4)))
 struct ble_ll_resolv_entry g_ble_ll_resolv_list[MYNEWT_VAL(BLE_LL_RESOLV_LIST_SIZE)];
 
+/*
+ * Open addressed (linear probing) index into g_ble_ll_resolv_list keyed on the
+ * identity address, kept at most half full. Holds the entry position (index
+ * plus 1) or 0 for an empty slot. Entries move around on add and remove, so
+ * the table is rebuilt whenever the list changes.
+ */
+#define BLE_LL_RESOLV_HASH_SIZE     (2 * MYNEWT_VAL(BLE_LL_RESOLV_LIST_SIZE))
+
+static uint8_t g_ble_ll_resolv_hash[BLE_LL_RESOLV_HASH_SIZE];
+
+#if MYNEWT_VAL(BLE_LL_RESOLV_RPA_CACHE_SIZE) > 0
+/*
+ * Recently resolved peer RPAs, most recent first. A peer keeps using the same
+ * RPA until its own RPA timeout expires, so repeated PDUs from it resolve with
+ * a compare instead of one AES operation per resolving list entry.
+ */
+struct ble_ll_resolv_rpa_cache_entry
+{
+    uint8_t rpa[BLE_DEV_ADDR_LEN];
+    int8_t rl_index;
+    ble_npl_time_t expiry;
+};
+
+static struct ble_ll_resolv_rpa_cache_entry
+    g_ble_ll_resolv_rpa_cache[MYNEWT_VAL(BLE_LL_RESOLV_RPA_CACHE_SIZE)];
+static uint8_t g_ble_ll_resolv_rpa_cache_cnt;
+
+/**
+ * Drop all cached RPA resolutions. Needs to be called whenever resolving list
+ * indices change.
+ */
+static void
+ble_ll_resolv_rpa_cache_flush(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    g_ble_ll_resolv_rpa_cache_cnt = 0;
+    OS_EXIT_CRITICAL(sr);
+}
+
+/**
+ * Look up an RPA in the cache. A hit is moved to the front.
+ *
+ * @return int resolving list index or -1 if not cached
+ */
+static int
+ble_ll_resolv_rpa_cache_find(const uint8_t *rpa)
+{
+    struct ble_ll_resolv_rpa_cache_entry e;
+    ble_npl_time_t now;
+    os_sr_t sr;
+    int rc;
+    int i;
+
+    rc = -1;
+    now = ble_npl_time_get();
+
+    OS_ENTER_CRITICAL(sr);
+    for (i = 0; i < g_ble_ll_resolv_rpa_cache_cnt; ++i) {
+        if (memcmp(g_ble_ll_resolv_rpa_cache[i].rpa, rpa, BLE_DEV_ADDR_LEN)) {
+            continue;
+        }
+
+        e = g_ble_ll_resolv_rpa_cache[i];
+
+        if ((int32_t)(now - e.expiry) >= 0) {
+            /* Stale, drop it and resolve the slow way */
+            --g_ble_ll_resolv_rpa_cache_cnt;
+            memmove(&g_ble_ll_resolv_rpa_cache[i],
+                    &g_ble_ll_resolv_rpa_cache[i + 1],
+                    (g_ble_ll_resolv_rpa_cache_cnt - i) *
+                    sizeof(g_ble_ll_resolv_rpa_cache[0]));
+            break;
+        }
+
+        memmove(&g_ble_ll_resolv_rpa_cache[1], &g_ble_ll_resolv_rpa_cache[0],
+                i * sizeof(g_ble_ll_resolv_rpa_cache[0]));
+        g_ble_ll_resolv_rpa_cache[0] = e;
+        rc = e.rl_index;
+        break;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+/**
+ * Insert a freshly resolved RPA at the front of the cache, evicting the least
+ * recently used entry if full.
+ */
+static void
+ble_ll_resolv_rpa_cache_add(const uint8_t *rpa, int rl_index)
+{
+    os_sr_t sr;
+    uint8_t cnt;
+
+    OS_ENTER_CRITICAL(sr);
+    cnt = g_ble_ll_resolv_rpa_cache_cnt;
+    if (cnt == MYNEWT_VAL(BLE_LL_RESOLV_RPA_CACHE_SIZE)) {
+        --cnt;
+    }
+
+    memmove(&g_ble_ll_resolv_rpa_cache[1], &g_ble_ll_resolv_rpa_cache[0],
+            cnt * sizeof(g_ble_ll_resolv_rpa_cache[0]));
+    memcpy(g_ble_ll_resolv_rpa_cache[0].rpa, rpa, BLE_DEV_ADDR_LEN);
+    g_ble_ll_resolv_rpa_cache[0].rl_index = rl_index;
+    g_ble_ll_resolv_rpa_cache[0].expiry = ble_npl_time_get() +
+                                          g_ble_ll_resolv_data.rpa_tmo;
+    g_ble_ll_resolv_rpa_cache_cnt = cnt + 1;
+    OS_EXIT_CRITICAL(sr);
+}
+#else
+#define ble_ll_resolv_rpa_cache_flush()
+#define ble_ll_resolv_rpa_cache_find(rpa)           (-1)
+#define ble_ll_resolv_rpa_cache_add(rpa, rl_index)
+#endif
+
 static int
 ble_ll_is_controller_busy(void)
 {
@@ -160,6 +279,28 @@ ble_ll_resolv_rpa_timer_cb(struct ble_npl_event *ev)
     ble_ll_adv_rpa_timeout();
 }
 
+static void
+ble_ll_resolv_hash_rebuild(void)
+{
+    struct ble_ll_resolv_entry *rl;
+    uint32_t slot;
+    int i;
+
+    memset(g_ble_ll_resolv_hash, 0, sizeof(g_ble_ll_resolv_hash));
+
+    for (i = 0; i < g_ble_ll_resolv_data.rl_cnt; ++i) {
+        rl = &g_ble_ll_resolv_list[i];
+        slot = ble_ll_utils_addr_hash(rl->rl_identity_addr, rl->rl_addr_type) %
+               BLE_LL_RESOLV_HASH_SIZE;
+
+        while (g_ble_ll_resolv_hash[slot]) {
+            slot = (slot + 1) % BLE_LL_RESOLV_HASH_SIZE;
+        }
+
+        g_ble_ll_resolv_hash[slot] = i + 1;
+    }
+}
+
 /**
  * Called to determine if the IRK is all zero.
  *
@@ -202,6 +343,8 @@ ble_ll_resolv_list_clr(void)
     g_ble_ll_resolv_data.rl_cnt_hw = 0;
     g_ble_ll_resolv_data.rl_cnt = 0;
     ble_hw_resolv_list_clear();
+    ble_ll_resolv_rpa_cache_flush();
+    ble_ll_resolv_hash_rebuild();
 
     /* stop RPA timer when clearing RL */
     ble_npl_callout_stop(&g_ble_ll_resolv_data.rpa_timer);
@@ -242,15 +385,25 @@ static int
 ble_ll_is_on_resolv_list(const uint8_t *addr, uint8_t addr_type)
 {
     int i;
+    int position;
+    uint32_t slot;
     struct ble_ll_resolv_entry *rl;
 
-    rl = &g_ble_ll_resolv_list[0];
-    for (i = 0; i < g_ble_ll_resolv_data.rl_cnt; ++i) {
+    slot = ble_ll_utils_addr_hash(addr, addr_type) % BLE_LL_RESOLV_HASH_SIZE;
+
+    for (i = 0; i < BLE_LL_RESOLV_HASH_SIZE; ++i) {
+        position = g_ble_ll_resolv_hash[slot];
+        if (!position) {
+            break;
+        }
+
+        rl = &g_ble_ll_resolv_list[position - 1];
         if ((rl->rl_addr_type == addr_type) &&
             (!memcmp(&rl->rl_identity_addr[0], addr, BLE_DEV_ADDR_LEN))) {
-            return i + 1;
+            return position;
         }
-        ++rl;
+
+        slot = (slot + 1) % BLE_LL_RESOLV_HASH_SIZE;
     }
 
     return 0;
@@ -267,16 +420,11 @@ ble_ll_is_on_resolv_list(const uint8_t *addr, uint8_t addr_type)
 struct ble_ll_resolv_entry *
 ble_ll_resolv_list_find(const uint8_t *addr, uint8_t addr_type)
 {
-    int i;
-    struct ble_ll_resolv_entry *rl;
+    int position;
 
-    rl = &g_ble_ll_resolv_list[0];
-    for (i = 0; i < g_ble_ll_resolv_data.rl_cnt; ++i) {
-        if ((rl->rl_addr_type == addr_type) &&
-            (!memcmp(&rl->rl_identity_addr[0], addr, BLE_DEV_ADDR_LEN))) {
-            return rl;
-        }
-        ++rl;
+    position = ble_ll_is_on_resolv_list(addr, addr_type);
+    if (position) {
+        return &g_ble_ll_resolv_list[position - 1];
     }
 
     return NULL;
@@ -317,6 +465,7 @@ ble_ll_resolv_list_add(const uint8_t *cmdbuf, uint8_t len)
 
     /* we keep this sorted in a way that entries with peer_irk are first */
     if (ble_ll_resolv_irk_nonzero(cmd->peer_irk)) {
+        ble_ll_resolv_rpa_cache_flush();
         memmove(&g_ble_ll_resolv_list[g_ble_ll_resolv_data.rl_cnt_hw + 1],
                 &g_ble_ll_resolv_list[g_ble_ll_resolv_data.rl_cnt_hw],
                 (g_ble_ll_resolv_data.rl_cnt - g_ble_ll_resolv_data.rl_cnt_hw) *
@@ -363,6 +512,7 @@ ble_ll_resolv_list_add(const uint8_t *cmdbuf, uint8_t len)
     }
 
     g_ble_ll_resolv_data.rl_cnt++;
+    ble_ll_resolv_hash_rebuild();
 
     /* start RPA timer if this was first element added to RL */
     if (g_ble_ll_resolv_data.rl_cnt == 1) {
@@ -400,11 +550,14 @@ ble_ll_resolv_list_rmv(const uint8_t *cmdbuf, uint8_t len)
     if (position) {
         BLE_LL_ASSERT(position <= g_ble_ll_resolv_data.rl_cnt);
 
+        ble_ll_resolv_rpa_cache_flush();
+
         memmove(&g_ble_ll_resolv_list[position - 1],
                 &g_ble_ll_resolv_list[position],
                 (g_ble_ll_resolv_data.rl_cnt - position) *
                 sizeof(g_ble_ll_resolv_list[0]));
         g_ble_ll_resolv_data.rl_cnt--;
+        ble_ll_resolv_hash_rebuild();
 
         /* Remove from HW list */
         if (position <= g_ble_ll_resolv_data.rl_cnt_hw) {
@@ -699,8 +852,14 @@ ble_ll_resolv_peer_rpa_any(const uint8_t *rpa)
 {
     int i;
 
+    i = ble_ll_resolv_rpa_cache_find(rpa);
+    if (i >= 0) {
+        return i;
+    }
+
     for (i = 0; i < g_ble_ll_resolv_data.rl_cnt_hw; i++) {
         if (ble_ll_resolv_rpa(rpa, g_ble_ll_resolv_list[i].rl_peer_irk)) {
+            ble_ll_resolv_rpa_cache_add(rpa, i);
             return i;
         }
     }
@@ -133,13 +133,51 @@ struct ble_ll_scan_dup_entry {
     uint16_t adi;
 #endif
     TAILQ_ENTRY(ble_ll_scan_dup_entry) link;
+    SLIST_ENTRY(ble_ll_scan_dup_entry) hlink;
 };
 
+/*
+ * Entries are kept in LRU order on g_scan_dup_list and additionally chained
+ * into hash buckets keyed on type and address, so a lookup does not have to
+ * walk the whole list for every received PDU.
+ */
+#define BLE_LL_SCAN_DUP_HASH_SIZE   (MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS))
+
 static os_membuf_t g_scan_dup_mem[ OS_MEMPOOL_SIZE(
                                    MYNEWT_VAL(BLE_LL_NUM_SCAN_DUP_ADVS),
                                    sizeof(struct ble_ll_scan_dup_entry)) ];
 static struct os_mempool g_scan_dup_pool;
 static TAILQ_HEAD(ble_ll_scan_dup_list, ble_ll_scan_dup_entry) g_scan_dup_list;
+static SLIST_HEAD(ble_ll_scan_dup_bucket, ble_ll_scan_dup_entry)
+    g_scan_dup_hash[BLE_LL_SCAN_DUP_HASH_SIZE];
+
+static inline struct ble_ll_scan_dup_bucket *
+ble_ll_scan_dup_bucket(uint8_t type, const uint8_t *addr)
+{
+    uint32_t h;
+    int i;
+
+    /* Anonymous entries have no address, they are stored zeroed */
+    h = type;
+    for (i = 0; i < BLE_DEV_ADDR_LEN; i++) {
+        h = (h * 31) + (addr ? addr[i] : 0);
+    }
+
+    return &g_scan_dup_hash[h % BLE_LL_SCAN_DUP_HASH_SIZE];
+}
+
+static void
+ble_ll_scan_dup_clear(void)
+{
+    int i;
+
+    os_mempool_clear(&g_scan_dup_pool);
+    TAILQ_INIT(&g_scan_dup_list);
+
+    for (i = 0; i < BLE_LL_SCAN_DUP_HASH_SIZE; i++) {
+        SLIST_INIT(&g_scan_dup_hash[i]);
+    }
+}
 
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
 #if MYNEWT_VAL(BLE_LL_EXT_ADV_AUX_PTR_CNT) != 0
@@ -1208,8 +1246,7 @@ ble_ll_scan_sm_start(struct ble_ll_scan_sm *scansm)
     /* Forget filtered advertisers from previous scan. */
     g_ble_ll_scan_num_rsp_advs = 0;
 
-    os_mempool_clear(&g_scan_dup_pool);
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_clear();
 
     /*
      * First scan window can start when RF is enabled. Add 1 tick since we are
@@ -2861,6 +2898,8 @@ ble_ll_scan_dup_new(void)
     if (!e) {
         e = TAILQ_LAST(&g_scan_dup_list, ble_ll_scan_dup_list);
         TAILQ_REMOVE(&g_scan_dup_list, e, link);
+        SLIST_REMOVE(ble_ll_scan_dup_bucket(e->type, e->addr), e,
+                     ble_ll_scan_dup_entry, hlink);
     }
 
     memset(e, 0, sizeof(*e));
@@ -2868,6 +2907,13 @@ ble_ll_scan_dup_new(void)
     return e;
 }
 
+static inline void
+ble_ll_scan_dup_insert(struct ble_ll_scan_dup_entry *e)
+{
+    TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
+    SLIST_INSERT_HEAD(ble_ll_scan_dup_bucket(e->type, e->addr), e, hlink);
+}
+
 static int
 ble_ll_scan_dup_check_legacy(uint8_t addr_type, uint8_t *addr, uint8_t pdu_type)
 {
@@ -2877,7 +2923,7 @@ ble_ll_scan_dup_check_legacy(uint8_t addr_type, uint8_t *addr, uint8_t pdu_type)
 
     type = BLE_LL_SCAN_ENTRY_TYPE_LEGACY(addr_type);
 
-    TAILQ_FOREACH(e, &g_scan_dup_list, link) {
+    SLIST_FOREACH(e, ble_ll_scan_dup_bucket(type, addr), hlink) {
         if ((e->type == type) && !memcmp(e->addr, addr, 6)) {
             break;
         }
@@ -2901,7 +2947,7 @@ ble_ll_scan_dup_check_legacy(uint8_t addr_type, uint8_t *addr, uint8_t pdu_type)
         e->type = type;
         memcpy(e->addr, addr, 6);
 
-        TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
+        ble_ll_scan_dup_insert(e);
     }
 
     return rc;
@@ -2925,7 +2971,7 @@ ble_ll_scan_dup_check_ext(uint8_t addr_type, uint8_t *addr,
 
     type = BLE_LL_SCAN_ENTRY_TYPE_EXT(addr_type, has_aux, is_anon, adi);
 
-    TAILQ_FOREACH(e, &g_scan_dup_list, link) {
+    SLIST_FOREACH(e, ble_ll_scan_dup_bucket(type, addr), hlink) {
         if ((e->type == type) &&
             (is_anon || !memcmp(e->addr, addr, BLE_DEV_ADDR_LEN))) {
             break;
@@ -2954,7 +3000,7 @@ ble_ll_scan_dup_check_ext(uint8_t addr_type, uint8_t *addr,
             memcpy(e->addr, addr, 6);
         }
 
-        TAILQ_INSERT_HEAD(&g_scan_dup_list, e, link);
+        ble_ll_scan_dup_insert(e);
     }
 
     return rc;
@@ -3940,8 +3986,7 @@ ble_ll_scan_reset(void)
     g_ble_ll_scan_num_rsp_advs = 0;
     memset(&g_ble_ll_scan_rsp_advs[0], 0, sizeof(g_ble_ll_scan_rsp_advs));
 
-    os_mempool_clear(&g_scan_dup_pool);
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_clear();
 
 #if MYNEWT_VAL(BLE_LL_CFG_FEAT_LL_EXT_ADV)
     /* clear memory pool for AUX scan results */
@@ -3979,7 +4024,7 @@ ble_ll_scan_init(void)
                           "ble_ll_scan_dup_pool");
     BLE_LL_ASSERT(err == 0);
 
-    TAILQ_INIT(&g_scan_dup_list);
+    ble_ll_scan_dup_clear();
 
     ble_ll_scan_common_init();
 }
@@ -299,4 +299,23 @@ ble_ll_utils_calc_window_widening(uint32_t anchor_point,
 
     return window_widening;
 }
+
+/**
+ * Hash a device address and its type, used to index the open addressed
+ * lookup tables of the whitelist and the resolving list.
+ */
+uint32_t
+ble_ll_utils_addr_hash(const uint8_t *addr, uint8_t addr_type)
+{
+    uint32_t h;
+    int i;
+
+    /* FNV-1a */
+    h = 2166136261u ^ addr_type;
+    for (i = 0; i < BLE_DEV_ADDR_LEN; ++i) {
+        h = (h ^ addr[i]) * 16777619u;
+    }
+
+    return h;
+}
 #endif
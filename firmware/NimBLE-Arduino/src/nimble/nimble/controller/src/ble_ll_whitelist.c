@@ -37,6 +37,7 @@
 #include "../include/controller/ble_ll_adv.h"
 #include "../include/controller/ble_ll_scan.h"
 #include "../include/controller/ble_hw.h"
+#include "../include/controller/ble_ll_utils.h"
 
 #if (MYNEWT_VAL(BLE_LL_WHITELIST_SIZE) < BLE_HW_WHITE_LIST_SIZE)
 #define BLE_LL_WHITELIST_SIZE       MYNEWT_VAL(BLE_LL_WHITELIST_SIZE)
@@ -53,6 +54,47 @@ struct ble_ll_whitelist_entry
 
 struct ble_ll_whitelist_entry g_ble_ll_whitelist[BLE_LL_WHITELIST_SIZE];
 
+/*
+ * Open addressed (linear probing) index into g_ble_ll_whitelist, kept at most
+ * half full. Holds the entry position (index plus 1) or 0 for an empty slot.
+ * Removal rebuilds the table, which is cheap for a list this size and avoids
+ * tombstones.
+ */
+#define BLE_LL_WHITELIST_HASH_SIZE  (2 * BLE_LL_WHITELIST_SIZE)
+
+static uint8_t g_ble_ll_whitelist_hash[BLE_LL_WHITELIST_HASH_SIZE];
+
+static void
+ble_ll_whitelist_hash_insert(int index)
+{
+    struct ble_ll_whitelist_entry *wl;
+    uint32_t slot;
+
+    wl = &g_ble_ll_whitelist[index];
+    slot = ble_ll_utils_addr_hash(wl->wl_dev_addr, wl->wl_addr_type) %
+           BLE_LL_WHITELIST_HASH_SIZE;
+
+    while (g_ble_ll_whitelist_hash[slot]) {
+        slot = (slot + 1) % BLE_LL_WHITELIST_HASH_SIZE;
+    }
+
+    g_ble_ll_whitelist_hash[slot] = index + 1;
+}
+
+static void
+ble_ll_whitelist_hash_rebuild(void)
+{
+    int i;
+
+    memset(g_ble_ll_whitelist_hash, 0, sizeof(g_ble_ll_whitelist_hash));
+
+    for (i = 0; i < BLE_LL_WHITELIST_SIZE; ++i) {
+        if (g_ble_ll_whitelist[i].wl_valid) {
+            ble_ll_whitelist_hash_insert(i);
+        }
+    }
+}
+
 static int
 ble_ll_whitelist_chg_allowed(void)
 {
@@ -95,6 +137,8 @@ ble_ll_whitelist_clear(void)
         ++wl;
     }
 
+    ble_ll_whitelist_hash_rebuild();
+
 #if (BLE_USES_HW_WHITELIST == 1)
     ble_hw_whitelist_clear();
 #endif
@@ -138,15 +182,25 @@ static int
 ble_ll_whitelist_search(const uint8_t *addr, uint8_t addr_type)
 {
     int i;
+    int position;
+    uint32_t slot;
     struct ble_ll_whitelist_entry *wl;
 
-    wl = &g_ble_ll_whitelist[0];
-    for (i = 0; i < BLE_LL_WHITELIST_SIZE; ++i) {
-        if ((wl->wl_valid) && (wl->wl_addr_type == addr_type) &&
+    slot = ble_ll_utils_addr_hash(addr, addr_type) % BLE_LL_WHITELIST_HASH_SIZE;
+
+    for (i = 0; i < BLE_LL_WHITELIST_HASH_SIZE; ++i) {
+        position = g_ble_ll_whitelist_hash[slot];
+        if (!position) {
+            break;
+        }
+
+        wl = &g_ble_ll_whitelist[position - 1];
+        if ((wl->wl_addr_type == addr_type) &&
             (!memcmp(&wl->wl_dev_addr[0], addr, BLE_DEV_ADDR_LEN))) {
-            return i + 1;
+            return position;
         }
-        ++wl;
+
+        slot = (slot + 1) % BLE_LL_WHITELIST_HASH_SIZE;
     }
 
     return 0;
@@ -217,6 +271,7 @@ ble_ll_whitelist_add(const uint8_t *cmdbuf, uint8_t len)
                 memcpy(&wl->wl_dev_addr[0], cmd->addr, BLE_DEV_ADDR_LEN);
                 wl->wl_addr_type = cmd->addr_type;
                 wl->wl_valid = 1;
+                ble_ll_whitelist_hash_insert(i);
                 break;
             }
             ++wl;
@@ -259,6 +314,7 @@ ble_ll_whitelist_rmv(const uint8_t *cmdbuf, uint8_t len)
     position = ble_ll_whitelist_search(cmd->addr, cmd->addr_type);
     if (position) {
         g_ble_ll_whitelist[position - 1].wl_valid = 0;
+        ble_ll_whitelist_hash_rebuild();
     }
 
 #if (BLE_USES_HW_WHITELIST == 1)
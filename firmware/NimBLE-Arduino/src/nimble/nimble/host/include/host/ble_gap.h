@@ -1951,6 +1951,60 @@ int ble_gap_wl_tx_rmv(const ble_addr_t *addrs);
 int ble_gap_update_params(uint16_t conn_handle,
                           const struct ble_gap_upd_params *params);
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+/**
+ * Connection event hook callback.
+ *
+ * @return                      Nonzero to be called again before the next
+ *                                  connection event, e.g. because not all
+ *                                  pending data fit into one report;
+ *                              0 to let the hook idle until the next call to
+ *                                  ble_gap_conn_event_hook_kick().
+ */
+typedef int ble_gap_conn_event_fn(uint16_t conn_handle, void *arg);
+
+/**
+ * Registers a callback to be called shortly before connection events of the
+ * specified connection, e.g. to assemble the freshest notification just in
+ * time.  The hook starts out idle; ble_gap_conn_event_hook_kick() arms it for
+ * the next connection event and it stays armed for as long as the callback
+ * returns nonzero.
+ *
+ * The controller does not report its anchor points, so the host predicts
+ * them from the arrival of Number Of Completed Packets events and the
+ * connection interval.  The callback runs in the esp_timer task with the host
+ * unlocked.  Only one connection can be hooked at a time; a new registration
+ * replaces the previous one.  The hook is removed automatically when the
+ * connection terminates.
+ *
+ * @param conn_handle           The handle of the connection to track.
+ * @param lead_us               How many microseconds before the predicted
+ *                                  connection event to call the callback.
+ * @param cb                    The callback to call; NULL removes the hook.
+ * @param cb_arg                The optional argument to pass to the
+ *                                  callback.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOTCONN if the there is no connection
+ *                                  with the specified handle;
+ *                              Other nonzero on error.
+ */
+int ble_gap_conn_event_hook_set(uint16_t conn_handle, uint32_t lead_us,
+                                ble_gap_conn_event_fn *cb, void *cb_arg);
+
+/**
+ * Arms the connection event hook for the next predicted connection event of
+ * the specified connection, unless it is armed already.
+ *
+ * @param conn_handle           The handle of the hooked connection.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOENT if no hook is registered for
+ *                                  the specified connection.
+ */
+int ble_gap_conn_event_hook_kick(uint16_t conn_handle);
+#endif
+
 /**
  * Configure LE Data Length in controller (OGF = 0x08, OCF = 0x0022).
  *
@@ -815,6 +815,35 @@ int ble_gatts_count_cfg(const struct ble_gatt_svc_def *defs);
  */
 void ble_gatts_chr_updated(uint16_t chr_val_handle);
 
+/** Only the newest queued notification of the characteristic is kept. */
+#define BLE_GATTS_TX_F_LATEST                           0x01
+
+/** Notifications of the characteristic are queued ahead of other traffic. */
+#define BLE_GATTS_TX_F_PRIO                             0x02
+
+/**
+ * Sets how notifications of a characteristic are treated while they wait for
+ * controller buffers on a congested connection. Has no effect on packets
+ * that can be handed to the controller right away.
+ *
+ * With BLE_GATTS_TX_F_LATEST a queued, not yet transmitted notification is
+ * replaced in place by a newer one for the same characteristic; use it only
+ * for values where the newest state supersedes all previous ones. With
+ * BLE_GATTS_TX_F_PRIO notifications are queued behind other priority packets
+ * but ahead of everything else.
+ *
+ * Policies refer to attribute handles and are dropped by ble_gatts_reset().
+ *
+ * @param chr_val_handle        Characteristic value handle
+ * @param flags                 Combination of BLE_GATTS_TX_F_*; 0 restores
+ *                                  the default FIFO behaviour.
+ *
+ * @return                      0 on success;
+ *                              BLE_HS_ENOMEM if all policy slots are in use;
+ *                              BLE_HS_ENOTSUP if policies are compiled out.
+ */
+int ble_gatts_set_tx_policy(uint16_t chr_val_handle, uint8_t flags);
+
 /**
  * Retrieves the attribute handle associated with a local GATT service.
  *
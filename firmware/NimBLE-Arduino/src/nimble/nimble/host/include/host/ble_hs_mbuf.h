@@ -56,6 +56,32 @@ struct os_mbuf *ble_hs_mbuf_att_pkt(void);
  */
 struct os_mbuf *ble_hs_mbuf_from_flat(const void *buf, uint16_t len);
 
+/**
+ * Allocates an mbuf suitable for a notification or indication value.  The
+ * resulting packet has exactly the leading space required for:
+ *  - ACL data header
+ *  - L2CAP B-frame header
+ *  - ATT handle value notification / indication header.
+ *
+ * All headers are prepended in place when the packet is sent, hence the
+ * value is not copied again on its way to the controller.
+ *
+ * @return An empty mbuf on success, NULL on error.
+ */
+struct os_mbuf *ble_hs_mbuf_att_value_pkt(void);
+
+/**
+ * Allocates an mbuf via ble_hs_mbuf_att_value_pkt() and fills it with the
+ * contents of the specified flat buffer.
+ *
+ * @param buf The flat buffer to copy from.
+ * @param len The length of the flat buffer.
+ *
+ * @return A newly-allocated mbuf on success, NULL on error.
+ */
+struct os_mbuf *ble_hs_mbuf_att_value_from_flat(const void *buf,
+                                                uint16_t len);
+
 /**
  * Copies the contents of an mbuf into the specified flat buffer.  If the flat
  * buffer is too small to contain the mbuf's contents, it is filled to capacity
@@ -334,6 +334,7 @@ uint8_t *bt_pub_key_get(void);
 int bt_rand(void *buf, size_t len);
 const char * bt_hex(const void *buf, size_t len);
 int bt_encrypt_be(const uint8_t *key, const uint8_t *plaintext, uint8_t *enc_data);
+void bt_mesh_key_sched_flush(void);
 int bt_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13], const uint8_t *enc_data,
 		   size_t len, const uint8_t *aad, size_t aad_len,
 		   uint8_t *plaintext, size_t mic_size);
@@ -88,6 +88,7 @@ static void app_key_del(struct bt_mesh_app_key *app)
 	app->net_idx = BT_MESH_KEY_UNUSED;
 	app->app_idx = BT_MESH_KEY_UNUSED;
 	(void)memset(app->keys, 0, sizeof(app->keys));
+	bt_mesh_key_sched_flush();
 }
 
 static void app_key_revoke(struct bt_mesh_app_key *app)
@@ -99,6 +100,7 @@ static void app_key_revoke(struct bt_mesh_app_key *app)
 	memcpy(&app->keys[0], &app->keys[1], sizeof(app->keys[0]));
 	memset(&app->keys[1], 0, sizeof(app->keys[1]));
 	app->updated = false;
+	bt_mesh_key_sched_flush();
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_store_app_key(app->app_idx);
@@ -143,6 +143,67 @@ bt_encrypt_be(const uint8_t *key, const uint8_t *plaintext, uint8_t *enc_data)
     return 0;
 }
 
+#else
+#if MYNEWT_VAL(BLE_MESH_KEY_SCHED_CACHE_SIZE) > 0
+/* Every CCM block and every obfuscation of a network PDU goes through
+ * bt_encrypt_be() with one of a handful of long lived keys (network
+ * encryption and privacy keys, the current app or device key), so keep the
+ * expanded schedules around instead of re-running the key expansion for
+ * each 16 byte block. Entries are replaced round robin. Like the rest of
+ * the mesh stack this is only used from the host task.
+ */
+static struct {
+    uint8_t key[16];
+    struct tc_aes_key_sched_struct sched;
+} key_sched_cache[MYNEWT_VAL(BLE_MESH_KEY_SCHED_CACHE_SIZE)];
+static uint8_t key_sched_cache_cnt;
+static uint8_t key_sched_cache_next;
+
+static struct tc_aes_key_sched_struct *
+key_sched_get(const uint8_t *key)
+{
+    int i;
+
+    for (i = 0; i < key_sched_cache_cnt; i++) {
+        if (_compare(key_sched_cache[i].key, key, 16) == 0) {
+            return &key_sched_cache[i].sched;
+        }
+    }
+
+    i = key_sched_cache_next;
+
+    /* leaves the schedule untouched on failure */
+    if (tc_aes128_set_encrypt_key(&key_sched_cache[i].sched, key) ==
+        TC_CRYPTO_FAIL) {
+        return NULL;
+    }
+
+    memcpy(key_sched_cache[i].key, key, 16);
+    key_sched_cache_next = (i + 1) % ARRAY_SIZE(key_sched_cache);
+
+    if (key_sched_cache_cnt < ARRAY_SIZE(key_sched_cache)) {
+        key_sched_cache_cnt++;
+    }
+
+    return &key_sched_cache[i].sched;
+}
+
+int
+bt_encrypt_be(const uint8_t *key, const uint8_t *plaintext, uint8_t *enc_data)
+{
+    struct tc_aes_key_sched_struct *s;
+
+    s = key_sched_get(key);
+    if (!s) {
+        return BLE_HS_EUNKNOWN;
+    }
+
+    if (tc_aes_encrypt(enc_data, plaintext, s) == TC_CRYPTO_FAIL) {
+        return BLE_HS_EUNKNOWN;
+    }
+
+    return 0;
+}
 #else
 int
 bt_encrypt_be(const uint8_t *key, const uint8_t *plaintext, uint8_t *enc_data)
@@ -160,6 +221,21 @@ bt_encrypt_be(const uint8_t *key, const uint8_t *plaintext, uint8_t *enc_data)
     return 0;
 }
 #endif
+#endif
+
+/* Wipes the cached keys and schedules, called whenever keys are deleted,
+ * revoked or the node is reset, so no stale key material stays in RAM.
+ */
+void
+bt_mesh_key_sched_flush(void)
+{
+#if !MYNEWT_VAL(BLE_CRYPTO_STACK_MBEDTLS) && \
+    MYNEWT_VAL(BLE_MESH_KEY_SCHED_CACHE_SIZE) > 0
+    _set(key_sched_cache, 0, sizeof(key_sched_cache));
+    key_sched_cache_cnt = 0;
+    key_sched_cache_next = 0;
+#endif
+}
 
 uint16_t
 net_buf_simple_pull_le16(struct os_mbuf *om)
@@ -205,6 +205,7 @@ void bt_mesh_reset(void)
 	}
 
 	memset(bt_mesh.dev_key, 0, sizeof(bt_mesh.dev_key));
+	bt_mesh_key_sched_flush();
 
 	bt_mesh_scan_disable();
 	bt_mesh_beacon_disable();
@@ -65,6 +65,12 @@ static struct {
 } msg_cache[MYNEWT_VAL(BLE_MESH_MSG_CACHE_SIZE)];
 static uint16_t msg_cache_next;
 
+/* Hash chains over msg_cache keyed by (src, seq). Links hold the entry
+ * index plus one, so zero terminates a chain.
+ */
+static uint16_t msg_cache_bucket[ARRAY_SIZE(msg_cache)];
+static uint16_t msg_cache_link[ARRAY_SIZE(msg_cache)];
+
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = STAILQ_HEAD_INITIALIZER(bt_mesh.local_queue),
@@ -99,13 +105,39 @@ static bool check_dup(struct os_mbuf *data)
 	return false;
 }
 
+static uint16_t msg_cache_hash(uint16_t src, uint32_t seq)
+{
+	return ((((uint32_t)src << 17) | seq) * 2654435761U) %
+	       ARRAY_SIZE(msg_cache);
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *link;
+
+	link = &msg_cache_bucket[msg_cache_hash(msg_cache[idx].src,
+						msg_cache[idx].seq)];
+
+	while (*link) {
+		if (*link == idx + 1) {
+			*link = msg_cache_link[idx];
+			return;
+		}
+
+		link = &msg_cache_link[*link - 1];
+	}
+}
+
 static bool msg_cache_match(struct os_mbuf *pdu)
 {
+	uint16_t src = SRC(pdu->om_data);
+	uint32_t seq = SEQ(pdu->om_data) & BIT_MASK(17);
 	uint16_t i;
 
-	for (i = 0; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->om_data) &&
-		    msg_cache[i].seq == (SEQ(pdu->om_data) & BIT_MASK(17))) {
+	for (i = msg_cache_bucket[msg_cache_hash(src, seq)]; i;
+	     i = msg_cache_link[i - 1]) {
+		if (msg_cache[i - 1].src == src &&
+		    msg_cache[i - 1].seq == seq) {
 			return true;
 		}
 	}
@@ -115,11 +147,24 @@ static bool msg_cache_match(struct os_mbuf *pdu)
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
-	/* Add to the cache */
-	rx->msg_cache_idx = msg_cache_next++;
-	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
-	msg_cache[rx->msg_cache_idx].seq = rx->seq;
+	uint16_t *head;
+	uint16_t idx;
+
+	/* Add to the cache, evicting the oldest entry */
+	idx = msg_cache_next++;
+	if (msg_cache[idx].src != BT_MESH_ADDR_UNASSIGNED) {
+		msg_cache_unlink(idx);
+	}
+
+	rx->msg_cache_idx = idx;
+	msg_cache[idx].src = rx->ctx.addr;
+	msg_cache[idx].seq = rx->seq;
 	msg_cache_next %= ARRAY_SIZE(msg_cache);
+
+	head = &msg_cache_bucket[msg_cache_hash(msg_cache[idx].src,
+						msg_cache[idx].seq)];
+	msg_cache_link[idx] = *head;
+	*head = idx + 1;
 }
 
 int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
@@ -143,6 +188,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 	}
 
 	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_bucket, 0, sizeof(msg_cache_bucket));
 	msg_cache_next = 0U;
 
 	bt_mesh.iv_index = iv_index;
@@ -797,6 +843,7 @@ void bt_mesh_net_recv(struct os_mbuf *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
+		msg_cache_unlink(rx.msg_cache_idx);
 		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
 		/* Rewind the next index now that we're not using this entry */
 		msg_cache_next = rx.msg_cache_idx;
@@ -22,12 +22,55 @@
 
 static struct bt_mesh_rpl replay_list[MYNEWT_VAL(BLE_MESH_CRPL)];
 
+/* Hash chains over replay_list keyed by source address. Links hold the
+ * entry index plus one, so zero terminates a chain. Entries cleared by
+ * memset elsewhere stay linked under their old address until they are
+ * reused; lookups skip them since the address no longer matches.
+ */
+static uint16_t rpl_bucket[ARRAY_SIZE(replay_list)];
+static uint16_t rpl_link[ARRAY_SIZE(replay_list)];
+static uint16_t rpl_linked_src[ARRAY_SIZE(replay_list)];
+
+static uint16_t rpl_hash(uint16_t src)
+{
+	return (uint16_t)(src * 40503U) % ARRAY_SIZE(replay_list);
+}
+
+static void rpl_index(struct bt_mesh_rpl *rpl)
+{
+	uint16_t idx = rpl - replay_list;
+	uint16_t *link;
+
+	if (rpl_linked_src[idx] == rpl->src) {
+		return;
+	}
+
+	if (rpl_linked_src[idx]) {
+		for (link = &rpl_bucket[rpl_hash(rpl_linked_src[idx])]; *link;
+		     link = &rpl_link[*link - 1]) {
+			if (*link == idx + 1) {
+				*link = rpl_link[idx];
+				break;
+			}
+		}
+	}
+
+	rpl_linked_src[idx] = rpl->src;
+
+	if (rpl->src) {
+		link = &rpl_bucket[rpl_hash(rpl->src)];
+		rpl_link[idx] = *link;
+		*link = idx + 1;
+	}
+}
+
 void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		struct bt_mesh_net_rx *rx)
 {
 	rpl->src = rx->ctx.addr;
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
+	rpl_index(rpl);
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_store_rpl(rpl);
@@ -42,6 +85,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	/* Don't bother checking messages from ourselves */
@@ -54,11 +98,16 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
 
-		/* Empty slot */
-		if (!rpl->src) {
+	/* Existing slot for given address */
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
+
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -66,26 +115,23 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		rpl = &replay_list[i];
 
-				return false;
+		/* Empty slot */
+		if (!rpl->src) {
+			if (match) {
+				*match = rpl;
 			} else {
-				return true;
+				bt_mesh_rpl_update(rpl, rx);
 			}
+
+			return false;
 		}
 	}
 
@@ -101,16 +147,18 @@ void bt_mesh_rpl_clear(void)
 		bt_mesh_clear_rpl();
 	} else {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		(void)memset(rpl_bucket, 0, sizeof(rpl_bucket));
+		(void)memset(rpl_linked_src, 0, sizeof(rpl_linked_src));
 	}
 }
 
 struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
-	int i;
+	uint16_t i;
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
+	for (i = rpl_bucket[rpl_hash(src)]; i; i = rpl_link[i - 1]) {
+		if (replay_list[i - 1].src == src) {
+			return &replay_list[i - 1];
 		}
 	}
 
@@ -124,6 +172,7 @@ struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (!replay_list[i].src) {
 			replay_list[i].src = src;
+			rpl_index(&replay_list[i]);
 			return &replay_list[i];
 		}
 	}
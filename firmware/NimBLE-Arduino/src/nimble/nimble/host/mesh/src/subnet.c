@@ -93,6 +93,7 @@ static void key_refresh(struct bt_mesh_subnet *sub, uint8_t new_phase)
 		sub->kr_phase = BT_MESH_KR_NORMAL;
 		memcpy(&sub->keys[0], &sub->keys[1], sizeof(sub->keys[0]));
 		sub->keys[1].valid = 0U;
+		bt_mesh_key_sched_flush();
 		subnet_evt(sub, BT_MESH_KEY_REVOKED);
 		break;
 	}
@@ -149,6 +150,7 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 	subnet_evt(sub, BT_MESH_KEY_DELETED);
 	(void)memset(sub, 0, sizeof(*sub));
 	sub->net_idx = BT_MESH_KEY_UNUSED;
+	bt_mesh_key_sched_flush();
 }
 
 static int msg_cred_create(struct bt_mesh_net_cred *cred, const uint8_t *p,
@@ -67,6 +67,12 @@
 	(BT_MESH_ADDR_IS_UNICAST(tx->dst) ?                                    \
 		 SEG_RETRANSMIT_TIMEOUT_UNICAST(tx) :                          \
 		 SEG_RETRANSMIT_TIMEOUT_GROUP)
+/* Bounds for the per missing segment share of the ack timeout. The upper
+ * bound is the fixed value used before segment arrival was tracked.
+ */
+#define SEG_RX_INTERVAL_MIN         K_MSEC(20)
+#define SEG_RX_INTERVAL_MAX         K_MSEC(100)
+
 /* How long to wait for available buffers before giving up */
 #define BUF_TIMEOUT                 K_NO_WAIT
 
@@ -117,6 +123,7 @@ static struct seg_rx {
 							 in_use:1,
 							 obo:1;
 	uint8_t                     ttl;
+	uint16_t                    interval; /* Smoothed seg interval (ms) */
 	uint32_t                    block;
 	uint32_t                    last;
 	struct k_delayed_work    ack;
@@ -804,6 +811,7 @@ static int trans_ack(struct bt_mesh_net_rx *rx, uint8_t hdr,
 {
 	struct seg_tx *tx;
 	unsigned int bit;
+	bool progress = false;
 	uint32_t ack;
 	uint16_t seq_zero;
 	uint8_t obo;
@@ -853,17 +861,29 @@ static int trans_ack(struct bt_mesh_net_rx *rx, uint8_t hdr,
 		return -EINVAL;
 	}
 
-	k_delayed_work_cancel(&tx->retransmit);
-
 	while ((bit = find_lsb_set(ack))) {
 		if (tx->seg[bit - 1]) {
 			BT_DBG("seg %u/%u acked", bit - 1, tx->seg_n);
 			seg_tx_done(tx, bit - 1);
+			progress = true;
 		}
 
 		ack &= ~BIT(bit - 1);
 	}
 
+	/* A repeated ack (e.g. the same ack heard through several relays)
+	 * while the previous round is still queued must not queue another
+	 * copy of every missing segment. The retransmit timer is kicked once
+	 * the queued segments are out.
+	 */
+	if (!progress && tx->seg_pending) {
+		BT_DBG("No new segments acked, %u still queued",
+		       tx->seg_pending);
+		return 0;
+	}
+
+	k_delayed_work_cancel(&tx->retransmit);
+
 	if (tx->nack_count) {
 		seg_tx_send_unacked(tx);
 	} else {
@@ -977,6 +997,7 @@ static int trans_unseg(struct os_mbuf *buf, struct bt_mesh_net_rx *rx,
 
 static inline int32_t ack_timeout(struct seg_rx *rx)
 {
+	int32_t per_seg;
 	int32_t to;
 	uint8_t ttl;
 
@@ -991,8 +1012,17 @@ static inline int32_t ack_timeout(struct seg_rx *rx)
 	 */
 	to = K_MSEC(150 + (50 * ttl));
 
-	/* 100 ms for every not yet received segment */
-	to += K_MSEC(((rx->seg_n + 1) - popcount(rx->block)) * 100);
+	/* Give every not yet received segment twice the observed segment
+	 * interval, or 100 ms until there's something to go by.
+	 */
+	if (rx->interval) {
+		per_seg = min(max(2 * rx->interval, SEG_RX_INTERVAL_MIN),
+			      SEG_RX_INTERVAL_MAX);
+	} else {
+		per_seg = SEG_RX_INTERVAL_MAX;
+	}
+
+	to += ((rx->seg_n + 1) - popcount(rx->block)) * per_seg;
 
 	/* Make sure we don't send more frequently than the duration for
 	 * each packet (default is 300ms).
@@ -1238,6 +1268,7 @@ static struct seg_rx *seg_rx_alloc(struct bt_mesh_net_rx *net_rx,
 		rx->src = net_rx->ctx.addr;
 		rx->dst = net_rx->ctx.recv_dst;
 		rx->block = 0;
+		rx->interval = 0;
 
 		BT_DBG("New RX context. Block Complete 0x%08x",
 		       (unsigned) BLOCK_COMPLETE(seg_n));
@@ -1419,6 +1450,17 @@ found_rx:
 		}
 	}
 
+	/* Track how fast segments arrive so the ack timer can follow the
+	 * sender instead of assuming the worst case.
+	 */
+	if (rx->block) {
+		uint32_t delta = k_uptime_get_32() - rx->last;
+
+		delta = min(delta, SEG_RX_INTERVAL_MAX);
+		rx->interval = rx->interval ?
+			       (3 * rx->interval + delta) / 4 : delta;
+	}
+
 	/* Reset the Incomplete Timer */
 	rx->last = k_uptime_get_32();
 
@@ -1445,6 +1487,20 @@ found_rx:
 	rx->block |= BIT(seg_o);
 
 	if (rx->block != BLOCK_COMPLETE(seg_n)) {
+		/* The last segment ends the sender's pass, anything still
+		 * missing at this point is lost rather than in flight. Pull
+		 * the ack in so the sender can start resending the holes.
+		 */
+		if (seg_o == seg_n && !bt_mesh_lpn_established()) {
+			int32_t timeout = ack_timeout(rx);
+
+			if (k_delayed_work_remaining_get(&rx->ack) >
+			    (uint32_t)timeout) {
+				k_delayed_work_submit(&rx->ack,
+						      K_MSEC(timeout));
+			}
+		}
+
 		*pdu_type = BT_MESH_FRIEND_PDU_PARTIAL;
 		return 0;
 	}
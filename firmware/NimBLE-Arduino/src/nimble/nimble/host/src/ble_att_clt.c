@@ -892,7 +892,6 @@ ble_att_clt_tx_notify(uint16_t conn_handle, uint16_t handle,
 #endif
 
     struct ble_att_notify_req *req;
-    struct os_mbuf *txom2;
     int rc;
 
     if (handle == 0) {
@@ -900,16 +899,19 @@ ble_att_clt_tx_notify(uint16_t conn_handle, uint16_t handle,
         goto err;
     }
 
-    req = ble_att_cmd_get(BLE_ATT_OP_NOTIFY_REQ, sizeof(*req), &txom2);
+    req = ble_att_cmd_prepend(BLE_ATT_OP_NOTIFY_REQ, sizeof(*req), &txom);
     if (req == NULL) {
-        rc = BLE_HS_ENOMEM;
-        goto err;
+        return BLE_HS_ENOMEM;
     }
 
     req->banq_handle = htole16(handle);
-    os_mbuf_concat(txom2, txom);
 
-    return ble_att_tx(conn_handle, txom2);
+    /* Tells the connection TX queue how to treat it if the link is backed up */
+    if (OS_MBUF_IS_PKTHDR(txom)) {
+        OS_MBUF_PKTHDR(txom)->omp_flags = ble_gatts_tx_policy(handle);
+    }
+
+    return ble_att_tx(conn_handle, txom);
 
 err:
     os_mbuf_free_chain(txom);
@@ -929,7 +931,6 @@ ble_att_clt_tx_indicate(uint16_t conn_handle, uint16_t handle,
 #endif
 
     struct ble_att_indicate_req *req;
-    struct os_mbuf *txom2;
     int rc;
 
     if (handle == 0) {
@@ -937,16 +938,14 @@ ble_att_clt_tx_indicate(uint16_t conn_handle, uint16_t handle,
         goto err;
     }
 
-    req = ble_att_cmd_get(BLE_ATT_OP_INDICATE_REQ, sizeof(*req), &txom2);
+    req = ble_att_cmd_prepend(BLE_ATT_OP_INDICATE_REQ, sizeof(*req), &txom);
     if (req == NULL) {
-        rc = BLE_HS_ENOMEM;
-        goto err;
+        return BLE_HS_ENOMEM;
     }
 
     req->baiq_handle = htole16(handle);
-    os_mbuf_concat(txom2, txom);
 
-    return ble_att_tx(conn_handle, txom2);
+    return ble_att_tx(conn_handle, txom);
 
 err:
     os_mbuf_free_chain(txom);
@@ -55,6 +55,50 @@ ble_att_cmd_get(uint8_t opcode, size_t len, struct os_mbuf **txom)
     return ble_att_cmd_prepare(opcode, len, *txom);
 }
 
+/**
+ * Puts an ATT command in front of the payload in txom.  If the payload was
+ * allocated with sufficient leading space (e.g., via
+ * ble_hs_mbuf_att_value_pkt()) the command is written in place, otherwise
+ * it is allocated separately and the payload is appended to it.
+ *
+ * On success txom points to the resulting packet.  On error the payload is
+ * freed.
+ */
+void *
+ble_att_cmd_prepend(uint8_t opcode, size_t len, struct os_mbuf **txom)
+{
+    struct ble_att_hdr *hdr;
+    struct os_mbuf *om;
+    void *cmd;
+
+    if (OS_MBUF_IS_PKTHDR(*txom) &&
+        OS_MBUF_LEADINGSPACE(*txom) >=
+        BLE_HS_MBUF_L2CAP_LEADINGSPACE + sizeof(*hdr) + len) {
+
+        *txom = os_mbuf_prepend(*txom, sizeof(*hdr) + len);
+        if (*txom == NULL) {
+            return NULL;
+        }
+
+        hdr = (struct ble_att_hdr *)(*txom)->om_data;
+        hdr->opcode = opcode;
+
+        return hdr->data;
+    }
+
+    cmd = ble_att_cmd_get(opcode, len, &om);
+    if (cmd == NULL) {
+        os_mbuf_free_chain(*txom);
+        *txom = NULL;
+        return NULL;
+    }
+
+    os_mbuf_concat(om, *txom);
+    *txom = om;
+
+    return cmd;
+}
+
 int
 ble_att_tx(uint16_t conn_handle, struct os_mbuf *txom)
 {
@@ -440,6 +440,7 @@ void ble_att_indicate_rsp_write(void *payload, int len);
 
 void *ble_att_cmd_prepare(uint8_t opcode, size_t len, struct os_mbuf *txom);
 void *ble_att_cmd_get(uint8_t opcode, size_t len, struct os_mbuf **txom);
+void *ble_att_cmd_prepend(uint8_t opcode, size_t len, struct os_mbuf **txom);
 int ble_att_tx(uint16_t conn_handle, struct os_mbuf *txom);
 
 #ifdef __cplusplus
@@ -65,6 +65,30 @@ static os_membuf_t ble_att_svr_prep_entry_mem[
 
 static struct os_mempool ble_att_svr_prep_entry_pool;
 
+#if MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT) > 0
+/**
+ * Largest discovery response kept in the cache.  This holds the complete
+ * service and characteristic lists of a typical HID device; longer responses
+ * are just not cached.
+ */
+#define BLE_ATT_SVR_DISC_CACHE_RSP_SZ   64
+
+/** A serialized discovery response and the request it answers. */
+struct ble_att_svr_disc_cache_entry {
+    ble_uuid_any_t uuid;
+    uint16_t start_handle;
+    uint16_t end_handle;
+    uint16_t mtu;
+    uint8_t op;
+    uint8_t len;
+    uint8_t rsp[BLE_ATT_SVR_DISC_CACHE_RSP_SZ];
+};
+
+static struct ble_att_svr_disc_cache_entry
+    ble_att_svr_disc_cache[MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT)];
+static uint16_t ble_att_svr_disc_cache_next;
+#endif
+
 static struct ble_att_svr_entry *
 ble_att_svr_entry_alloc(void)
 {
@@ -97,6 +121,19 @@ ble_att_svr_next_id(void)
     return ++ble_att_svr_id;
 }
 
+/**
+ * Drops all cached discovery responses.  Must be called whenever the
+ * attribute table changes.
+ */
+static void
+ble_att_svr_disc_cache_clear(void)
+{
+#if MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT) > 0
+    memset(ble_att_svr_disc_cache, 0, sizeof ble_att_svr_disc_cache);
+    ble_att_svr_disc_cache_next = 0;
+#endif
+}
+
 /**
  * Register a host attribute with the BLE stack.
  *
@@ -128,6 +165,7 @@ ble_att_svr_register(const ble_uuid_t *uuid, uint8_t flags,
     entry->ha_cb_arg = cb_arg;
 
     STAILQ_INSERT_TAIL(&ble_att_svr_list, entry, ha_next);
+    ble_att_svr_disc_cache_clear();
 
     if (handle_id != NULL) {
         *handle_id = entry->ha_handle_id;
@@ -767,6 +805,97 @@ done:
     return rc;
 }
 
+/**
+ * Looks up a cached response to the specified discovery request.  On a hit,
+ * the request buffer is reused for the response.
+ *
+ * @param uuid                  The attribute type of the request, or NULL for
+ *                                  requests without one.
+ *
+ * @return                      0 on a hit; BLE_HS_ENOENT otherwise.
+ */
+static int
+ble_att_svr_disc_cache_get(uint16_t conn_handle, uint8_t op,
+                           uint16_t start_handle, uint16_t end_handle,
+                           const ble_uuid_t *uuid, struct os_mbuf **rxom,
+                           struct os_mbuf **out_txom)
+{
+#if MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT) > 0
+    struct ble_att_svr_disc_cache_entry *entry;
+    uint16_t mtu;
+    int rc;
+    int i;
+
+    mtu = ble_att_mtu(conn_handle);
+
+    for (i = 0; i < MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT); i++) {
+        entry = &ble_att_svr_disc_cache[i];
+        if (entry->op != op ||
+            entry->start_handle != start_handle ||
+            entry->end_handle != end_handle ||
+            entry->mtu != mtu ||
+            (uuid != NULL && ble_uuid_cmp(&entry->uuid.u, uuid) != 0)) {
+
+            continue;
+        }
+
+        os_mbuf_adj(*rxom, OS_MBUF_PKTLEN(*rxom));
+        rc = os_mbuf_append(*rxom, entry->rsp, entry->len);
+        if (rc != 0) {
+            /* Leave the request buffer to the regular response path. */
+            os_mbuf_adj(*rxom, OS_MBUF_PKTLEN(*rxom));
+            return BLE_HS_ENOENT;
+        }
+
+        *out_txom = *rxom;
+        *rxom = NULL;
+        return 0;
+    }
+#endif
+
+    return BLE_HS_ENOENT;
+}
+
+/**
+ * Stores a successfully built discovery response in the cache, replacing the
+ * oldest entry.
+ */
+static void
+ble_att_svr_disc_cache_put(uint16_t conn_handle, uint8_t op,
+                           uint16_t start_handle, uint16_t end_handle,
+                           const ble_uuid_t *uuid, struct os_mbuf *txom)
+{
+#if MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT) > 0
+    struct ble_att_svr_disc_cache_entry *entry;
+    uint16_t len;
+    int rc;
+
+    len = OS_MBUF_PKTLEN(txom);
+    if (len > BLE_ATT_SVR_DISC_CACHE_RSP_SZ) {
+        return;
+    }
+
+    entry = &ble_att_svr_disc_cache[ble_att_svr_disc_cache_next];
+    ble_att_svr_disc_cache_next = (ble_att_svr_disc_cache_next + 1) %
+                                  MYNEWT_VAL(BLE_ATT_SVR_DISC_CACHE_CNT);
+
+    rc = os_mbuf_copydata(txom, 0, len, entry->rsp);
+    if (rc != 0) {
+        entry->op = 0;
+        return;
+    }
+
+    if (uuid != NULL) {
+        ble_uuid_copy(&entry->uuid, uuid);
+    }
+    entry->start_handle = start_handle;
+    entry->end_handle = end_handle;
+    entry->mtu = ble_att_mtu(conn_handle);
+    entry->op = op;
+    entry->len = len;
+#endif
+}
+
 /**
  * Fills the supplied mbuf with the variable length Information Data field of a
  * Find Information ATT response.
@@ -933,6 +1062,13 @@ ble_att_svr_rx_find_info(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    rc = ble_att_svr_disc_cache_get(conn_handle, BLE_ATT_OP_FIND_INFO_REQ,
+                                    start_handle, end_handle, NULL,
+                                    rxom, &txom);
+    if (rc == 0) {
+        goto done;
+    }
+
     rc = ble_att_svr_build_find_info_rsp(conn_handle,
                                         start_handle, end_handle,
                                         rxom, &txom, &att_err);
@@ -941,6 +1077,9 @@ ble_att_svr_rx_find_info(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    ble_att_svr_disc_cache_put(conn_handle, BLE_ATT_OP_FIND_INFO_REQ,
+                               start_handle, end_handle, NULL, txom);
+
     rc = 0;
 
 done:
@@ -1373,6 +1512,17 @@ done:
     return rc;
 }
 
+static int
+ble_att_svr_is_cacheable_read_type(const ble_uuid_t *uuid)
+{
+    uint16_t uuid16;
+
+    uuid16 = ble_uuid_u16(uuid);
+
+    return uuid16 == BLE_ATT_UUID_INCLUDE ||
+           uuid16 == BLE_ATT_UUID_CHARACTERISTIC;
+}
+
 int
 ble_att_svr_rx_read_type(uint16_t conn_handle, struct os_mbuf **rxom)
 {
@@ -1387,6 +1537,7 @@ ble_att_svr_rx_read_type(uint16_t conn_handle, struct os_mbuf **rxom)
     uint16_t pktlen;
     ble_uuid_any_t uuid;
     uint8_t att_err;
+    int cacheable;
     int rc;
 
     /* Initialize some values in case of early error. */
@@ -1426,6 +1577,19 @@ ble_att_svr_rx_read_type(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    /* Only declarations are cached; other attribute values are read through
+     * the application and may change or depend on the connection.
+     */
+    cacheable = ble_att_svr_is_cacheable_read_type(&uuid.u);
+    if (cacheable) {
+        rc = ble_att_svr_disc_cache_get(conn_handle, BLE_ATT_OP_READ_TYPE_REQ,
+                                        start_handle, end_handle, &uuid.u,
+                                        rxom, &txom);
+        if (rc == 0) {
+            goto done;
+        }
+    }
+
     rc = ble_att_svr_build_read_type_rsp(conn_handle, start_handle, end_handle,
                                          &uuid.u, rxom, &txom, &att_err,
                                          &err_handle);
@@ -1433,6 +1597,11 @@ ble_att_svr_rx_read_type(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    if (cacheable) {
+        ble_att_svr_disc_cache_put(conn_handle, BLE_ATT_OP_READ_TYPE_REQ,
+                                   start_handle, end_handle, &uuid.u, txom);
+    }
+
     rc = 0;
 
 done:
@@ -1919,6 +2088,14 @@ ble_att_svr_rx_read_group_type(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    rc = ble_att_svr_disc_cache_get(conn_handle,
+                                    BLE_ATT_OP_READ_GROUP_TYPE_REQ,
+                                    start_handle, end_handle, &uuid.u,
+                                    rxom, &txom);
+    if (rc == 0) {
+        goto done;
+    }
+
     rc = ble_att_svr_build_read_group_type_rsp(conn_handle, start_handle,
                                                end_handle, &uuid.u,
                                                rxom, &txom, &att_err,
@@ -1927,6 +2104,9 @@ ble_att_svr_rx_read_group_type(uint16_t conn_handle, struct os_mbuf **rxom)
         goto done;
     }
 
+    ble_att_svr_disc_cache_put(conn_handle, BLE_ATT_OP_READ_GROUP_TYPE_REQ,
+                               start_handle, end_handle, &uuid.u, txom);
+
     rc = 0;
 
 done:
@@ -2590,6 +2770,8 @@ ble_att_svr_move_entries(struct ble_att_svr_entry_list *src,
     struct ble_att_svr_entry *remove;
     struct ble_att_svr_entry *insert;
 
+    ble_att_svr_disc_cache_clear();
+
     /* Find first matching element to move */
     remove = NULL;
     entry = STAILQ_FIRST(src);
@@ -2668,6 +2850,8 @@ ble_att_svr_reset(void)
         ble_att_svr_entry_free(entry);
     }
 
+    ble_att_svr_disc_cache_clear();
+
     /* Note: prep entries do not get freed here because it is assumed there are
      * no established connections.
      */
@@ -2744,6 +2928,7 @@ ble_att_svr_init(void)
 
     STAILQ_INIT(&ble_att_svr_list);
     STAILQ_INIT(&ble_att_svr_hidden_list);
+    ble_att_svr_disc_cache_clear();
 
     ble_att_svr_id = 0;
 
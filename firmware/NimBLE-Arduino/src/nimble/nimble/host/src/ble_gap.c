@@ -40,6 +40,10 @@
 #define bssnz_t
 #endif
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+#include "esp_timer.h"
+#endif
+
 /**
  * GAP - Generic Access Profile.
  *
@@ -259,6 +263,10 @@ static int ble_gap_conn_cancel_tx(void);
 static int ble_gap_disc_enable_tx(int enable, int filter_duplicates);
 #endif
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+static void ble_gap_conn_event_hook_clear(uint16_t conn_handle);
+#endif
+
 STATS_SECT_DECL(ble_gap_stats) ble_gap_stats;
 STATS_NAME_START(ble_gap_stats)
     STATS_NAME(ble_gap_stats, wl_set)
@@ -1304,6 +1312,9 @@ ble_gap_conn_broken(uint16_t conn_handle, int reason)
     ble_gatts_connection_broken(conn_handle);
     ble_gattc_connection_broken(conn_handle);
     ble_hs_flow_connection_broken(conn_handle);;
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+    ble_gap_conn_event_hook_clear(conn_handle);
+#endif
 
     ble_hs_atomic_conn_delete(conn_handle);
 
@@ -6617,6 +6628,182 @@ ble_gap_event_listener_call(struct ble_gap_event *event)
     return 0;
 }
 
+/*****************************************************************************
+ * $conn event hook                                                          *
+ *****************************************************************************/
+
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+/**
+ * The controller does not report connection event anchor points to the host.
+ * They are approximated by the arrival of Number Of Completed Packets events,
+ * which the controller sends right after the connection event in which the
+ * peer acknowledged our data.  The resulting estimate is late by the event
+ * length plus the HCI latency, which the application's lead time covers.
+ * Between such events the estimate is extrapolated at the connection interval.
+ *
+ * The timer only runs while the application has data pending, i.e. from a
+ * call to ble_gap_conn_event_hook_kick() until the callback returns 0, so an
+ * idle connection does not wake the host.
+ */
+static struct {
+    ble_gap_conn_event_fn *cb;
+    void *cb_arg;
+    esp_timer_handle_t timer;
+    int64_t anchor;
+    uint32_t lead_us;
+    uint16_t conn_handle;
+    uint8_t armed;
+} ble_gap_conn_event_hook;
+
+/**
+ * Arms the hook timer for the first predicted connection event whose lead
+ * time has not passed yet.
+ *
+ * Lock restrictions:
+ *     o Caller locks host.
+ */
+static void
+ble_gap_conn_event_hook_arm(int64_t now)
+{
+    struct ble_hs_conn *conn;
+    int64_t next;
+    uint32_t itvl;
+
+    conn = ble_hs_conn_find(ble_gap_conn_event_hook.conn_handle);
+    if (conn == NULL || conn->bhc_itvl == 0) {
+        return;
+    }
+
+    itvl = conn->bhc_itvl * BLE_HCI_CONN_ITVL;
+    next = ble_gap_conn_event_hook.anchor + itvl;
+    if (next - ble_gap_conn_event_hook.lead_us <= now) {
+        next += ((now - (next - ble_gap_conn_event_hook.lead_us)) / itvl + 1) *
+                itvl;
+    }
+
+    ble_gap_conn_event_hook.anchor = next;
+    ble_gap_conn_event_hook.armed = 1;
+
+    esp_timer_stop(ble_gap_conn_event_hook.timer);
+    esp_timer_start_once(ble_gap_conn_event_hook.timer,
+                         next - ble_gap_conn_event_hook.lead_us - now);
+}
+
+static void
+ble_gap_conn_event_hook_exp(void *unused)
+{
+    ble_gap_conn_event_fn *cb;
+    uint16_t conn_handle;
+    void *cb_arg;
+
+    ble_hs_lock();
+
+    cb = ble_gap_conn_event_hook.cb;
+    cb_arg = ble_gap_conn_event_hook.cb_arg;
+    conn_handle = ble_gap_conn_event_hook.conn_handle;
+    ble_gap_conn_event_hook.armed = 0;
+
+    ble_hs_unlock();
+
+    if (cb != NULL && cb(conn_handle, cb_arg) != 0) {
+        ble_gap_conn_event_hook_kick(conn_handle);
+    }
+}
+
+/**
+ * Re-synchronizes the hook to a connection event that just completed.  Called
+ * when a Number Of Completed Packets event arrives for the connection.
+ */
+void
+ble_gap_conn_event_hook_sync(uint16_t conn_handle)
+{
+    int64_t now;
+
+    ble_hs_lock();
+
+    if (ble_gap_conn_event_hook.cb != NULL &&
+        ble_gap_conn_event_hook.conn_handle == conn_handle) {
+
+        now = esp_timer_get_time();
+        ble_gap_conn_event_hook.anchor = now;
+        if (ble_gap_conn_event_hook.armed) {
+            ble_gap_conn_event_hook_arm(now);
+        }
+    }
+
+    ble_hs_unlock();
+}
+
+static void
+ble_gap_conn_event_hook_clear(uint16_t conn_handle)
+{
+    ble_hs_lock();
+
+    if (ble_gap_conn_event_hook.cb != NULL &&
+        ble_gap_conn_event_hook.conn_handle == conn_handle) {
+
+        esp_timer_stop(ble_gap_conn_event_hook.timer);
+        ble_gap_conn_event_hook.cb = NULL;
+        ble_gap_conn_event_hook.armed = 0;
+    }
+
+    ble_hs_unlock();
+}
+
+int
+ble_gap_conn_event_hook_kick(uint16_t conn_handle)
+{
+    int rc;
+
+    ble_hs_lock();
+
+    if (ble_gap_conn_event_hook.cb == NULL ||
+        ble_gap_conn_event_hook.conn_handle != conn_handle) {
+        rc = BLE_HS_ENOENT;
+    } else {
+        if (!ble_gap_conn_event_hook.armed) {
+            ble_gap_conn_event_hook_arm(esp_timer_get_time());
+        }
+        rc = 0;
+    }
+
+    ble_hs_unlock();
+
+    return rc;
+}
+
+int
+ble_gap_conn_event_hook_set(uint16_t conn_handle, uint32_t lead_us,
+                            ble_gap_conn_event_fn *cb, void *cb_arg)
+{
+    int rc;
+
+    ble_hs_lock();
+
+    esp_timer_stop(ble_gap_conn_event_hook.timer);
+    ble_gap_conn_event_hook.cb = NULL;
+    ble_gap_conn_event_hook.armed = 0;
+
+    if (cb == NULL) {
+        rc = 0;
+    } else if (ble_hs_conn_find(conn_handle) == NULL) {
+        rc = BLE_HS_ENOTCONN;
+    } else {
+        ble_gap_conn_event_hook.cb = cb;
+        ble_gap_conn_event_hook.cb_arg = cb_arg;
+        ble_gap_conn_event_hook.conn_handle = conn_handle;
+        ble_gap_conn_event_hook.lead_us = lead_us;
+        ble_gap_conn_event_hook.anchor = esp_timer_get_time();
+
+        rc = 0;
+    }
+
+    ble_hs_unlock();
+
+    return rc;
+}
+#endif
+
 /*****************************************************************************
  * $init                                                                     *
  *****************************************************************************/
@@ -6661,6 +6848,24 @@ ble_gap_init(void)
         goto err;
     }
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+    if (ble_gap_conn_event_hook.timer == NULL) {
+        esp_timer_create_args_t create_args = {
+            .callback = ble_gap_conn_event_hook_exp,
+            .arg = NULL,
+            .name = "ble_gap_conn_evt",
+        };
+
+        if (esp_timer_create(&create_args,
+                             &ble_gap_conn_event_hook.timer) != ESP_OK) {
+            rc = BLE_HS_ENOMEM;
+            goto err;
+        }
+    }
+    ble_gap_conn_event_hook.cb = NULL;
+    ble_gap_conn_event_hook.armed = 0;
+#endif
+
     return 0;
 
 err:
@@ -6671,6 +6876,15 @@ void
 ble_gap_deinit(void)
 {
     ble_npl_mutex_deinit(&preempt_done_mutex);
+
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+    if (ble_gap_conn_event_hook.timer != NULL) {
+        esp_timer_stop(ble_gap_conn_event_hook.timer);
+        esp_timer_delete(ble_gap_conn_event_hook.timer);
+        ble_gap_conn_event_hook.timer = NULL;
+    }
+    ble_gap_conn_event_hook.cb = NULL;
+#endif
 }
 
 int
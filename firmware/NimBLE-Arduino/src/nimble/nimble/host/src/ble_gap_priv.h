@@ -148,6 +148,10 @@ void ble_gap_conn_broken(uint16_t conn_handle, int reason);
 void ble_gap_reset_state(int reason);
 int32_t ble_gap_timer(void);
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+void ble_gap_conn_event_hook_sync(uint16_t conn_handle);
+#endif
+
 int ble_gap_init(void);
 void ble_gap_deinit(void);
 
@@ -176,6 +176,11 @@ struct ble_gatt_resources {
 int ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle);
 int ble_gatts_send_next_indicate(uint16_t conn_handle);
 void ble_gatts_tx_notifications(void);
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+uint8_t ble_gatts_tx_policy(uint16_t chr_val_handle);
+#else
+#define ble_gatts_tx_policy(chr_val_handle) 0
+#endif
 void ble_gatts_bonding_established(uint16_t conn_handle);
 void ble_gatts_bonding_restored(uint16_t conn_handle);
 void ble_gatts_connection_broken(uint16_t conn_handle);
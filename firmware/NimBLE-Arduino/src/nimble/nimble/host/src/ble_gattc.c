@@ -36,13 +36,13 @@
  * Notes on thread-safety:
  * 1. The ble_hs mutex must never be locked when an application callback is
  *    executed.  A callback is free to initiate additional host procedures.
- * 2. The only resource protected by the mutex is the list of active procedures
- *    (ble_gattc_procs).  Thread-safety is achieved by locking the mutex during
- *    removal and insertion operations.  Procedure objects are only modified
- *    while they are not in the list.  This is sufficient, as the host parent
- *    task is the only task which inspects or modifies individual procedure
- *    entries.  Tasks have the following permissions regarding procedure
- *    entries:
+ * 2. The only resources protected by the mutex are the lists of active
+ *    procedures (ble_gattc_procs and ble_gattc_procs_exp).  Thread-safety
+ *    is achieved by locking the mutex during removal and insertion
+ *    operations.  Procedure objects are only modified while they are not in
+ *    the list.  This is sufficient, as the host parent task is the only task
+ *    which inspects or modifies individual procedure entries.  Tasks have the
+ *    following permissions regarding procedure entries:
  *
  *                | insert  | remove    | inspect   | modify
  *    ------------+---------+-----------|-----------|---------
@@ -104,6 +104,7 @@
 /** Represents an in-progress GATT procedure. */
 struct ble_gattc_proc {
     STAILQ_ENTRY(ble_gattc_proc) next;
+    TAILQ_ENTRY(ble_gattc_proc) exp_next;
 
     uint32_t exp_os_ticks;
     uint16_t conn_handle;
@@ -220,6 +221,7 @@ struct ble_gattc_proc {
 };
 
 STAILQ_HEAD(ble_gattc_proc_list, ble_gattc_proc);
+TAILQ_HEAD(ble_gattc_proc_exp_list, ble_gattc_proc);
 
 /**
  * Error functions - these handle an incoming ATT error response and apply it
@@ -422,8 +424,18 @@ static os_membuf_t ble_gattc_proc_mem[
 
 static struct os_mempool ble_gattc_proc_pool;
 
-/* The list of active GATT client procedures. */
-static struct ble_gattc_proc_list ble_gattc_procs;
+/* Active GATT client procedures, hashed by connection handle.  Incoming
+ * responses and connection events only inspect the procedures of their own
+ * connection.
+ */
+#define BLE_GATTC_PROC_BUCKET_CNT   MYNEWT_VAL(BLE_MAX_CONNECTIONS)
+static struct ble_gattc_proc_list ble_gattc_procs[BLE_GATTC_PROC_BUCKET_CNT];
+
+/* All active GATT client procedures, ordered by expiry time.  Every procedure
+ * uses the same unresponsive timeout, so insertion is almost always at the
+ * tail and the timer only looks at the entries which actually expired.
+ */
+static struct ble_gattc_proc_exp_list ble_gattc_procs_exp;
 
 /* The time when we should attempt to resume stalled procedures, in OS ticks.
  * A value of 0 indicates no stalled procedures.
@@ -482,7 +494,7 @@ ble_gattc_dbg_assert_proc_not_inserted(struct ble_gattc_proc *proc)
 
     ble_hs_lock();
 
-    STAILQ_FOREACH(cur, &ble_gattc_procs, next) {
+    TAILQ_FOREACH(cur, &ble_gattc_procs_exp, exp_next) {
         BLE_HS_DBG_ASSERT(cur != proc);
     }
 
@@ -732,13 +744,43 @@ ble_gattc_proc_free(struct ble_gattc_proc *proc)
     }
 }
 
+/**
+ * Retrieves the proc list which holds the procedures of the specified
+ * connection.
+ */
+static struct ble_gattc_proc_list *
+ble_gattc_proc_bucket(uint16_t conn_handle)
+{
+    return &ble_gattc_procs[conn_handle % BLE_GATTC_PROC_BUCKET_CNT];
+}
+
 static void
 ble_gattc_proc_insert(struct ble_gattc_proc *proc)
 {
+    struct ble_gattc_proc *prev;
+
     ble_gattc_dbg_assert_proc_not_inserted(proc);
 
     ble_hs_lock();
-    STAILQ_INSERT_TAIL(&ble_gattc_procs, proc, next);
+
+    STAILQ_INSERT_TAIL(ble_gattc_proc_bucket(proc->conn_handle), proc, next);
+
+    /* Keep the expiry list sorted; only stalled procedures, which retain their
+     * original expiry time, are placed in front of the tail.
+     */
+    prev = TAILQ_LAST(&ble_gattc_procs_exp, ble_gattc_proc_exp_list);
+    while (prev != NULL &&
+           (int32_t)(prev->exp_os_ticks - proc->exp_os_ticks) > 0) {
+
+        prev = TAILQ_PREV(prev, ble_gattc_proc_exp_list, exp_next);
+    }
+
+    if (prev == NULL) {
+        TAILQ_INSERT_HEAD(&ble_gattc_procs_exp, proc, exp_next);
+    } else {
+        TAILQ_INSERT_AFTER(&ble_gattc_procs_exp, prev, proc, exp_next);
+    }
+
     ble_hs_unlock();
 }
 
@@ -875,33 +917,6 @@ ble_gattc_proc_matches_conn_op(struct ble_gattc_proc *proc, void *arg)
     return 1;
 }
 
-struct ble_gattc_criteria_exp {
-    ble_npl_time_t now;
-    int32_t next_exp_in;
-};
-
-static int
-ble_gattc_proc_matches_expired(struct ble_gattc_proc *proc, void *arg)
-{
-    struct ble_gattc_criteria_exp *criteria;
-    int32_t time_diff;
-
-    criteria = arg;
-
-    time_diff = proc->exp_os_ticks - criteria->now;
-
-    if (time_diff <= 0) {
-        /* Procedure is expired. */
-        return 1;
-    }
-
-    /* Procedure isn't expired; determine if it is the next to expire. */
-    if (time_diff < criteria->next_exp_in) {
-        criteria->next_exp_in = time_diff;
-    }
-    return 0;
-}
-
 struct ble_gattc_criteria_conn_rx_entry {
     uint16_t conn_handle;
     const void *rx_entries;
@@ -929,41 +944,41 @@ ble_gattc_proc_matches_conn_rx_entry(struct ble_gattc_proc *proc, void *arg)
     return (criteria->matching_rx_entry != NULL);
 }
 
-static void
-ble_gattc_extract(ble_gattc_match_fn *cb, void *arg, int max_procs,
-                  struct ble_gattc_proc_list *dst_list)
+/**
+ * Moves the procs of a single bucket which match the specified criteria to
+ * the destination list.  The caller must hold the host lock.
+ *
+ * @return                      The number of procs extracted.
+ */
+static int
+ble_gattc_extract_bucket(struct ble_gattc_proc_list *bucket,
+                         ble_gattc_match_fn *cb, void *arg, int max_procs,
+                         struct ble_gattc_proc_list *dst_list)
 {
     struct ble_gattc_proc *proc;
     struct ble_gattc_proc *prev;
     struct ble_gattc_proc *next;
     int num_extracted;
 
-    /* Only the parent task is allowed to remove entries from the list. */
-    BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
-
-    STAILQ_INIT(dst_list);
     num_extracted = 0;
 
-    ble_hs_lock();
-
     prev = NULL;
-    proc = STAILQ_FIRST(&ble_gattc_procs);
+    proc = STAILQ_FIRST(bucket);
     while (proc != NULL) {
         next = STAILQ_NEXT(proc, next);
 
         if (cb(proc, arg)) {
             if (prev == NULL) {
-                STAILQ_REMOVE_HEAD(&ble_gattc_procs, next);
+                STAILQ_REMOVE_HEAD(bucket, next);
             } else {
-                STAILQ_REMOVE_AFTER(&ble_gattc_procs, prev, next);
+                STAILQ_REMOVE_AFTER(bucket, prev, next);
             }
+            TAILQ_REMOVE(&ble_gattc_procs_exp, proc, exp_next);
             STAILQ_INSERT_TAIL(dst_list, proc, next);
 
-            if (max_procs > 0) {
-                num_extracted++;
-                if (num_extracted >= max_procs) {
-                    break;
-                }
+            num_extracted++;
+            if (max_procs > 0 && num_extracted >= max_procs) {
+                break;
             }
         } else {
             prev = proc;
@@ -972,15 +987,57 @@ ble_gattc_extract(ble_gattc_match_fn *cb, void *arg, int max_procs,
         proc = next;
     }
 
+    return num_extracted;
+}
+
+/**
+ * Removes procs matching the specified criteria from the active lists.
+ *
+ * @param conn_handle           The connection to search, or
+ *                                  BLE_HS_CONN_HANDLE_NONE to search all
+ *                                  connections.
+ * @param max_procs             The maximum number of procs to extract, or 0
+ *                                  for no limit.
+ */
+static void
+ble_gattc_extract(uint16_t conn_handle, ble_gattc_match_fn *cb, void *arg,
+                  int max_procs, struct ble_gattc_proc_list *dst_list)
+{
+    int num_extracted;
+    int i;
+
+    /* Only the parent task is allowed to remove entries from the list. */
+    BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
+
+    STAILQ_INIT(dst_list);
+
+    ble_hs_lock();
+
+    if (conn_handle != BLE_HS_CONN_HANDLE_NONE) {
+        ble_gattc_extract_bucket(ble_gattc_proc_bucket(conn_handle), cb, arg,
+                                 max_procs, dst_list);
+    } else {
+        for (i = 0; i < BLE_GATTC_PROC_BUCKET_CNT; i++) {
+            num_extracted = ble_gattc_extract_bucket(&ble_gattc_procs[i], cb,
+                                                     arg, max_procs, dst_list);
+            if (max_procs > 0) {
+                max_procs -= num_extracted;
+                if (max_procs <= 0) {
+                    break;
+                }
+            }
+        }
+    }
+
     ble_hs_unlock();
 }
 
 static struct ble_gattc_proc *
-ble_gattc_extract_one(ble_gattc_match_fn *cb, void *arg)
+ble_gattc_extract_one(uint16_t conn_handle, ble_gattc_match_fn *cb, void *arg)
 {
     struct ble_gattc_proc_list dst_list;
 
-    ble_gattc_extract(cb, arg, 1, &dst_list);
+    ble_gattc_extract(conn_handle, cb, arg, 1, &dst_list);
     return STAILQ_FIRST(&dst_list);
 }
 
@@ -993,7 +1050,8 @@ ble_gattc_extract_by_conn_op(uint16_t conn_handle, uint8_t op, int max_procs,
     criteria.conn_handle = conn_handle;
     criteria.op = op;
 
-    ble_gattc_extract(ble_gattc_proc_matches_conn_op, &criteria, max_procs, dst_list);
+    ble_gattc_extract(conn_handle, ble_gattc_proc_matches_conn_op, &criteria,
+                      max_procs, dst_list);
 }
 
 static struct ble_gattc_proc *
@@ -1014,7 +1072,8 @@ ble_gattc_proc_matches_stalled(struct ble_gattc_proc *proc, void *unused)
 static void
 ble_gattc_extract_stalled(struct ble_gattc_proc_list *dst_list)
 {
-    ble_gattc_extract(ble_gattc_proc_matches_stalled, NULL, 0, dst_list);
+    ble_gattc_extract(BLE_HS_CONN_HANDLE_NONE, ble_gattc_proc_matches_stalled,
+                      NULL, 0, dst_list);
 }
 
 /**
@@ -1024,15 +1083,37 @@ ble_gattc_extract_stalled(struct ble_gattc_proc_list *dst_list)
 static int32_t
 ble_gattc_extract_expired(struct ble_gattc_proc_list *dst_list)
 {
-    struct ble_gattc_criteria_exp criteria;
+    struct ble_gattc_proc *proc;
+    ble_npl_time_t now;
+    int32_t next_exp_in;
+    int32_t time_diff;
 
-    criteria.now = ble_npl_time_get();
-    criteria.next_exp_in = BLE_HS_FOREVER;
+    /* Only the parent task is allowed to remove entries from the list. */
+    BLE_HS_DBG_ASSERT(ble_hs_is_parent_task());
 
     STAILQ_INIT(dst_list);
-    ble_gattc_extract(ble_gattc_proc_matches_expired, &criteria, 0, dst_list);
+    next_exp_in = BLE_HS_FOREVER;
+    now = ble_npl_time_get();
 
-    return criteria.next_exp_in;
+    ble_hs_lock();
+
+    /* The expiry list is sorted; stop at the first unexpired procedure. */
+    while ((proc = TAILQ_FIRST(&ble_gattc_procs_exp)) != NULL) {
+        time_diff = proc->exp_os_ticks - now;
+        if (time_diff > 0) {
+            next_exp_in = time_diff;
+            break;
+        }
+
+        STAILQ_REMOVE(ble_gattc_proc_bucket(proc->conn_handle), proc,
+                      ble_gattc_proc, next);
+        TAILQ_REMOVE(&ble_gattc_procs_exp, proc, exp_next);
+        STAILQ_INSERT_TAIL(dst_list, proc, next);
+    }
+
+    ble_hs_unlock();
+
+    return next_exp_in;
 }
 
 static struct ble_gattc_proc *
@@ -1048,7 +1129,8 @@ ble_gattc_extract_with_rx_entry(uint16_t conn_handle,
     criteria.num_rx_entries = num_rx_entries;
     criteria.matching_rx_entry = NULL;
 
-    proc = ble_gattc_extract_one(ble_gattc_proc_matches_conn_rx_entry,
+    proc = ble_gattc_extract_one(conn_handle,
+                                 ble_gattc_proc_matches_conn_rx_entry,
                                  &criteria);
     *out_rx_entry = criteria.matching_rx_entry;
 
@@ -1056,8 +1138,8 @@ ble_gattc_extract_with_rx_entry(uint16_t conn_handle,
 }
 
 /**
- * Searches the main proc list for an entry whose connection handle and op code
- * match those specified.  If a matching entry is found, it is removed from the
+ * Searches the proc list of the specified connection for an entry whose op code
+ * matches the response.  If a matching entry is found, it is removed from the
  * list and returned.
  *
  * @param conn_handle           The connection handle to match against.
@@ -4175,7 +4257,7 @@ ble_gatts_notify_custom(uint16_t conn_handle, uint16_t chr_val_handle,
         /* No custom attribute data; read the value from the specified
          * attribute.
          */
-        txom = ble_hs_mbuf_att_pkt();
+        txom = ble_hs_mbuf_att_value_pkt();
         if (txom == NULL) {
             rc = BLE_HS_ENOMEM;
             goto done;
@@ -4350,7 +4432,7 @@ ble_gatts_indicate_custom(uint16_t conn_handle, uint16_t chr_val_handle,
         /* No custom attribute data; read the value from the specified
          * attribute.
          */
-        txom = ble_hs_mbuf_att_pkt();
+        txom = ble_hs_mbuf_att_value_pkt();
         if (txom == NULL) {
             rc = BLE_HS_ENOMEM;
             goto done;
@@ -4826,15 +4908,19 @@ ble_gattc_connection_broken(uint16_t conn_handle)
 int
 ble_gattc_any_jobs(void)
 {
-    return !STAILQ_EMPTY(&ble_gattc_procs);
+    return !TAILQ_EMPTY(&ble_gattc_procs_exp);
 }
 
 int
 ble_gattc_init(void)
 {
     int rc;
+    int i;
 
-    STAILQ_INIT(&ble_gattc_procs);
+    for (i = 0; i < BLE_GATTC_PROC_BUCKET_CNT; i++) {
+        STAILQ_INIT(&ble_gattc_procs[i]);
+    }
+    TAILQ_INIT(&ble_gattc_procs_exp);
 
     if (MYNEWT_VAL(BLE_GATT_MAX_PROCS) > 0) {
         rc = os_mempool_init(&ble_gattc_proc_pool,
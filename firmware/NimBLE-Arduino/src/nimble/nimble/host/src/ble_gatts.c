@@ -68,6 +68,17 @@ struct ble_gatts_clt_cfg {
 static struct ble_gatts_clt_cfg *ble_gatts_clt_cfgs;
 static int ble_gatts_num_cfgable_chrs;
 
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+struct ble_gatts_tx_policy {
+    uint16_t chr_val_handle;
+    uint8_t flags;
+};
+
+/** Characteristics whose notifications get special treatment when queued. */
+static struct ble_gatts_tx_policy
+    ble_gatts_tx_policies[MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT)];
+#endif
+
 STATS_SECT_DECL(ble_gatts_stats) ble_gatts_stats;
 STATS_NAME_START(ble_gatts_stats)
     STATS_NAME(ble_gatts_stats, svcs)
@@ -1518,6 +1529,83 @@ ble_gatts_rx_indicate_ack(uint16_t conn_handle, uint16_t chr_val_handle)
     return 0;
 }
 
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+int
+ble_gatts_set_tx_policy(uint16_t chr_val_handle, uint8_t flags)
+{
+    struct ble_gatts_tx_policy *free_policy;
+    struct ble_gatts_tx_policy *policy;
+    int i;
+
+    if (chr_val_handle == 0 ||
+        (flags & ~(BLE_GATTS_TX_F_LATEST | BLE_GATTS_TX_F_PRIO)) != 0) {
+        return BLE_HS_EINVAL;
+    }
+
+    ble_hs_lock();
+
+    free_policy = NULL;
+    policy = NULL;
+    for (i = 0; i < MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT); i++) {
+        if (ble_gatts_tx_policies[i].chr_val_handle == chr_val_handle) {
+            policy = ble_gatts_tx_policies + i;
+            break;
+        }
+
+        if (free_policy == NULL &&
+            ble_gatts_tx_policies[i].chr_val_handle == 0) {
+            free_policy = ble_gatts_tx_policies + i;
+        }
+    }
+
+    if (policy == NULL) {
+        policy = free_policy;
+    }
+
+    if (policy == NULL) {
+        ble_hs_unlock();
+        return flags ? BLE_HS_ENOMEM : 0;
+    }
+
+    if (flags) {
+        policy->chr_val_handle = chr_val_handle;
+        policy->flags = flags;
+    } else {
+        policy->chr_val_handle = 0;
+    }
+
+    ble_hs_unlock();
+
+    return 0;
+}
+
+uint8_t
+ble_gatts_tx_policy(uint16_t chr_val_handle)
+{
+    uint8_t flags;
+    int i;
+
+    flags = 0;
+
+    ble_hs_lock();
+    for (i = 0; i < MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT); i++) {
+        if (ble_gatts_tx_policies[i].chr_val_handle == chr_val_handle) {
+            flags = ble_gatts_tx_policies[i].flags;
+            break;
+        }
+    }
+    ble_hs_unlock();
+
+    return flags;
+}
+#else
+int
+ble_gatts_set_tx_policy(uint16_t chr_val_handle, uint8_t flags)
+{
+    return BLE_HS_ENOTSUP;
+}
+#endif
+
 void
 ble_gatts_chr_updated(uint16_t chr_val_handle)
 {
@@ -2192,6 +2280,9 @@ ble_gatts_reset(void)
         /* Unregister all ATT attributes. */
         ble_att_svr_reset();
         ble_gatts_num_cfgable_chrs = 0;
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+        memset(ble_gatts_tx_policies, 0, sizeof(ble_gatts_tx_policies));
+#endif
         rc = 0;
 
         /* Note: gatts memory gets freed on next call to ble_gatts_start(). */
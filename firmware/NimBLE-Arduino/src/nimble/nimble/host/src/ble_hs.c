@@ -44,10 +44,27 @@ static void ble_hs_event_start_stage1(struct ble_npl_event *ev);
 static void ble_hs_event_start_stage2(struct ble_npl_event *ev);
 static void ble_hs_timer_sched(int32_t ticks_from_now);
 
+#if MYNEWT_VAL(BLE_HS_HCI_EVT_BATCH)
+/**
+ * Ring of HCI event buffers received from the controller but not yet
+ * processed.  A single OS event drains the whole ring, so a burst of
+ * controller events costs one host task wakeup instead of one per packet.
+ * One slot is left unused to tell a full ring from an empty one.
+ */
+#define BLE_HS_HCI_EVT_RING_SZ  (BLE_HS_HCI_EVT_COUNT + 1)
+
+static uint8_t *ble_hs_hci_evt_ring[BLE_HS_HCI_EVT_RING_SZ];
+static uint16_t ble_hs_hci_evt_ring_head;
+static uint16_t ble_hs_hci_evt_ring_tail;
+
+/** OS event - triggers processing of all queued HCI events. */
+static struct ble_npl_event ble_hs_ev_rx_hci_batch;
+#else
 struct os_mempool ble_hs_hci_ev_pool;
 static os_membuf_t ble_hs_hci_os_event_buf[
     OS_MEMPOOL_SIZE(BLE_HS_HCI_EVT_COUNT, sizeof (struct ble_npl_event))
 ];
+#endif
 
 /** OS event - triggers tx of pending notifications and indications. */
 static struct ble_npl_event ble_hs_ev_tx_notifications;
@@ -375,6 +392,8 @@ ble_hs_sync(void)
                        rc);
         }
 
+        ble_sm_sc_key_pool_fill();
+
         if (ble_hs_cfg.sync_cb != NULL) {
             ble_hs_cfg.sync_cb();
         }
@@ -526,6 +545,89 @@ ble_hs_sched_start(void)
 #endif
 }
 
+#if MYNEWT_VAL(BLE_HS_HCI_EVT_BATCH)
+/**
+ * Removes the oldest HCI event from the ring.
+ *
+ * @return                      The event buffer, or NULL if the ring is empty.
+ */
+static uint8_t *
+ble_hs_hci_evt_ring_pop(void)
+{
+    os_sr_t sr;
+    uint8_t *hci_evt;
+
+    OS_ENTER_CRITICAL(sr);
+    if (ble_hs_hci_evt_ring_head == ble_hs_hci_evt_ring_tail) {
+        hci_evt = NULL;
+    } else {
+        hci_evt = ble_hs_hci_evt_ring[ble_hs_hci_evt_ring_tail];
+        ble_hs_hci_evt_ring_tail =
+            (ble_hs_hci_evt_ring_tail + 1) % BLE_HS_HCI_EVT_RING_SZ;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    return hci_evt;
+}
+
+/**
+ * Appends an HCI event to the ring.
+ *
+ * @return                      0 on success; BLE_HS_ENOMEM if the ring is
+ *                                  full.
+ */
+static int
+ble_hs_hci_evt_ring_push(uint8_t *hci_evt)
+{
+    uint16_t next;
+    os_sr_t sr;
+    int rc;
+
+    OS_ENTER_CRITICAL(sr);
+    next = (ble_hs_hci_evt_ring_head + 1) % BLE_HS_HCI_EVT_RING_SZ;
+    if (next == ble_hs_hci_evt_ring_tail) {
+        rc = BLE_HS_ENOMEM;
+    } else {
+        ble_hs_hci_evt_ring[ble_hs_hci_evt_ring_head] = hci_evt;
+        ble_hs_hci_evt_ring_head = next;
+        rc = 0;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+/**
+ * Frees all HCI events still queued in the ring.
+ */
+static void
+ble_hs_hci_evt_ring_flush(void)
+{
+    uint8_t *hci_evt;
+
+    while ((hci_evt = ble_hs_hci_evt_ring_pop()) != NULL) {
+        ble_hci_trans_buf_free(hci_evt);
+    }
+}
+
+static void
+ble_hs_event_rx_hci_ev(struct ble_npl_event *ev)
+{
+    const struct ble_hci_ev *hci_ev;
+
+    /* Events queued while this handler runs re-post the OS event, which then
+     * finds the ring empty; that is cheaper than a wakeup per event.
+     */
+    while ((hci_ev = (void *)ble_hs_hci_evt_ring_pop()) != NULL) {
+#if BLE_MONITOR
+        ble_monitor_send(BLE_MONITOR_OPCODE_EVENT_PKT, hci_ev,
+                         hci_ev->length + sizeof(*hci_ev));
+#endif
+
+        ble_hs_hci_evt_process(hci_ev);
+    }
+}
+#else
 static void
 ble_hs_event_rx_hci_ev(struct ble_npl_event *ev)
 {
@@ -547,6 +649,7 @@ ble_hs_event_rx_hci_ev(struct ble_npl_event *ev)
 
     ble_hs_hci_evt_process(hci_ev);
 }
+#endif
 
 #if NIMBLE_BLE_CONNECT
 static void
@@ -599,6 +702,23 @@ ble_hs_event_start_stage2(struct ble_npl_event *ev)
     assert(rc == 0);
 }
 
+#if MYNEWT_VAL(BLE_HS_HCI_EVT_BATCH)
+void
+ble_hs_enqueue_hci_event(uint8_t *hci_evt)
+{
+#if CONFIG_NIMBLE_STACK_USE_MEM_POOLS
+    if (ble_hs_evq->eventq && ble_hs_hci_evt_ring_push(hci_evt) == 0) {
+#else
+    if (ble_hs_evq->q && ble_hs_hci_evt_ring_push(hci_evt) == 0) {
+#endif
+        /* No-op if the drain event is already pending. */
+        ble_npl_eventq_put(ble_hs_evq, &ble_hs_ev_rx_hci_batch);
+    } else {
+        /* Either the ring is full or queue doesn't exist */
+        ble_hci_trans_buf_free(hci_evt);
+    }
+}
+#else
 void
 ble_hs_enqueue_hci_event(uint8_t *hci_evt)
 {
@@ -617,6 +737,7 @@ ble_hs_enqueue_hci_event(uint8_t *hci_evt)
         ble_hci_trans_buf_free(hci_evt);
     }
 }
+#endif
 
 /**
  * Schedules for all pending notifications and indications to be sent in the
@@ -758,11 +879,17 @@ ble_hs_init(void)
     /* Ensure this function only gets called by sysinit. */
     SYSINIT_ASSERT_ACTIVE();
 
+#if MYNEWT_VAL(BLE_HS_HCI_EVT_BATCH)
+    ble_hs_hci_evt_ring_head = 0;
+    ble_hs_hci_evt_ring_tail = 0;
+    ble_npl_event_init(&ble_hs_ev_rx_hci_batch, ble_hs_event_rx_hci_ev, NULL);
+#else
     /* Create memory pool of OS events */
     rc = os_mempool_init(&ble_hs_hci_ev_pool, BLE_HS_HCI_EVT_COUNT,
                          sizeof (struct ble_npl_event), ble_hs_hci_os_event_buf,
                          "ble_hs_hci_ev_pool");
     SYSINIT_PANIC_ASSERT(rc == 0);
+#endif
 
     /* These get initialized here to allow unit tests to run without a zeroed
      * bss.
@@ -878,8 +1005,15 @@ ble_hs_deinit(void)
 
     ble_gap_deinit();
 
+    ble_sm_sc_key_pool_deinit();
+
     ble_hs_hci_deinit();
 
+#if MYNEWT_VAL(BLE_HS_HCI_EVT_BATCH)
+    ble_hs_hci_evt_ring_flush();
+    ble_npl_event_deinit(&ble_hs_ev_rx_hci_batch);
+#endif
+
     ble_npl_event_deinit(&ble_hs_ev_start_stage2);
 
     ble_npl_event_deinit(&ble_hs_ev_start_stage1);
@@ -264,6 +264,111 @@ ble_hs_conn_free(struct ble_hs_conn *conn)
     STATS_INC(ble_hs_stats, conn_delete);
 }
 
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+/**
+ * Reads the part of a queued L2CAP packet that identifies an ATT
+ * notification: channel ID, ATT opcode and attribute handle.
+ */
+static int
+ble_hs_conn_txq_key(struct os_mbuf *om, uint8_t *key)
+{
+    return os_mbuf_copydata(om, BLE_L2CAP_HDR_SZ - 2, 5, key);
+}
+
+/**
+ * Replaces a queued packet carrying a notification for the same attribute
+ * with the supplied one.
+ *
+ * @return                      0 if a packet was replaced; nonzero otherwise.
+ */
+static int
+ble_hs_conn_txq_replace(struct ble_hs_conn *conn,
+                        struct os_mbuf_pkthdr *first,
+                        struct os_mbuf *om)
+{
+    struct os_mbuf_pkthdr *omp;
+    uint8_t old_key[5];
+    uint8_t key[5];
+
+    if (ble_hs_conn_txq_key(om, key) != 0) {
+        return BLE_HS_EINVAL;
+    }
+
+    for (omp = first; omp != NULL; omp = STAILQ_NEXT(omp, omp_next)) {
+        if (!(omp->omp_flags & BLE_GATTS_TX_F_LATEST) ||
+            ble_hs_conn_txq_key(OS_MBUF_PKTHDR_TO_MBUF(omp), old_key) != 0 ||
+            memcmp(old_key, key, sizeof(key)) != 0) {
+            continue;
+        }
+
+        STAILQ_INSERT_AFTER(&conn->bhc_tx_q, omp, OS_MBUF_PKTHDR(om),
+                            omp_next);
+        STAILQ_REMOVE(&conn->bhc_tx_q, omp, os_mbuf_pkthdr, omp_next);
+        os_mbuf_free_chain(OS_MBUF_PKTHDR_TO_MBUF(omp));
+
+        return 0;
+    }
+
+    return BLE_HS_ENOENT;
+}
+#endif
+
+/**
+ * Queues an outgoing packet that the controller could not take yet.
+ *
+ * Packets are sent in FIFO order unless tagged with a GATT TX policy (see
+ * ble_gatts_set_tx_policy()): priority packets are queued behind other
+ * priority packets but ahead of the rest, and a "latest" packet replaces an
+ * older queued notification for the same attribute. A partially transmitted
+ * packet at the head of the queue is never touched, the controller waits for
+ * its remainder.
+ */
+void
+ble_hs_conn_txq_insert(struct ble_hs_conn *conn, struct os_mbuf *om)
+{
+#if MYNEWT_VAL(BLE_GATTS_TX_POLICY_CNT) > 0
+    struct os_mbuf_pkthdr *first;
+    struct os_mbuf_pkthdr *prev;
+    struct os_mbuf_pkthdr *omp;
+    uint16_t flags;
+
+    BLE_HS_DBG_ASSERT(ble_hs_locked_by_cur_task());
+
+    flags = OS_MBUF_IS_PKTHDR(om) ? OS_MBUF_PKTHDR(om)->omp_flags : 0;
+
+    first = STAILQ_FIRST(&conn->bhc_tx_q);
+    prev = NULL;
+    if (first != NULL && (conn->bhc_flags & BLE_HS_CONN_F_TX_FRAG)) {
+        prev = first;
+        first = STAILQ_NEXT(first, omp_next);
+    }
+
+    if (flags & BLE_GATTS_TX_F_LATEST &&
+        ble_hs_conn_txq_replace(conn, first, om) == 0) {
+        return;
+    }
+
+    if (flags & BLE_GATTS_TX_F_PRIO) {
+        for (omp = first;
+             omp != NULL && (omp->omp_flags & BLE_GATTS_TX_F_PRIO);
+             omp = STAILQ_NEXT(omp, omp_next)) {
+            prev = omp;
+        }
+
+        if (prev == NULL) {
+            STAILQ_INSERT_HEAD(&conn->bhc_tx_q, OS_MBUF_PKTHDR(om), omp_next);
+        } else {
+            STAILQ_INSERT_AFTER(&conn->bhc_tx_q, prev, OS_MBUF_PKTHDR(om),
+                                omp_next);
+        }
+
+        return;
+    }
+#endif
+
+    STAILQ_INSERT_TAIL(&conn->bhc_tx_q, OS_MBUF_PKTHDR(om), omp_next);
+}
+
 void
 ble_hs_conn_insert(struct ble_hs_conn *conn)
 {
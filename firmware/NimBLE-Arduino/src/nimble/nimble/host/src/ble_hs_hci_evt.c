@@ -351,6 +351,10 @@ ble_hs_hci_evt_num_completed_pkts(uint8_t event_code, const void *data,
                 ble_hs_hci_add_avail_pkts(num_pkts);
             }
             ble_hs_unlock();
+
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+            ble_gap_conn_event_hook_sync(le16toh(ev->completed[i].handle));
+#endif
         }
     }
 
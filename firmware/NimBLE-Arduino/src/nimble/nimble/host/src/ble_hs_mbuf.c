@@ -66,11 +66,7 @@ ble_hs_mbuf_bare_pkt(void)
 struct os_mbuf *
 ble_hs_mbuf_acl_pkt(void)
 {
-#if CONFIG_BT_NIMBLE_LEGACY_VHCI_ENABLE
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + 1);
-#else
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_HS_CTRL_DATA_HDR_SZ + 1);
-#endif
+    return ble_hs_mbuf_gen_pkt(BLE_HS_MBUF_ACL_LEADINGSPACE);
 }
 
 /**
@@ -85,11 +81,7 @@ ble_hs_mbuf_acl_pkt(void)
 struct os_mbuf *
 ble_hs_mbuf_l2cap_pkt(void)
 {
-#if CONFIG_BT_NIMBLE_LEGACY_VHCI_ENABLE
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ + 1);
-#else
-    return ble_hs_mbuf_gen_pkt(BLE_HCI_DATA_HDR_SZ + BLE_L2CAP_HDR_SZ + BLE_HS_CTRL_DATA_HDR_SZ + 1);
-#endif
+    return ble_hs_mbuf_gen_pkt(BLE_HS_MBUF_L2CAP_LEADINGSPACE);
 }
 
 struct os_mbuf *
@@ -123,6 +115,34 @@ ble_hs_mbuf_from_flat(const void *buf, uint16_t len)
     return om;
 }
 
+struct os_mbuf *
+ble_hs_mbuf_att_value_pkt(void)
+{
+    /* Notify and indicate share the same command layout. */
+    return ble_hs_mbuf_gen_pkt(BLE_HS_MBUF_L2CAP_LEADINGSPACE +
+                               BLE_ATT_NOTIFY_REQ_BASE_SZ);
+}
+
+struct os_mbuf *
+ble_hs_mbuf_att_value_from_flat(const void *buf, uint16_t len)
+{
+    struct os_mbuf *om;
+    int rc;
+
+    om = ble_hs_mbuf_att_value_pkt();
+    if (om == NULL) {
+        return NULL;
+    }
+
+    rc = os_mbuf_append(om, buf, len);
+    if (rc != 0) {
+        os_mbuf_free_chain(om);
+        return NULL;
+    }
+
+    return om;
+}
+
 int
 ble_hs_mbuf_to_flat(const struct os_mbuf *om, void *flat, uint16_t max_len,
                     uint16_t *out_copy_len)
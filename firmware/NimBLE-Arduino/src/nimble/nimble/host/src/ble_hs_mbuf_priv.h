@@ -26,6 +26,21 @@ extern "C" {
 
 struct os_mbuf;
 
+/**
+ * Leading space required to prepend the HCI ACL data header, including the
+ * controller data header and the HCI packet type indicator.
+ */
+#if CONFIG_BT_NIMBLE_LEGACY_VHCI_ENABLE
+#define BLE_HS_MBUF_ACL_LEADINGSPACE    (BLE_HCI_DATA_HDR_SZ + 1)
+#else
+#define BLE_HS_MBUF_ACL_LEADINGSPACE    \
+    (BLE_HCI_DATA_HDR_SZ + BLE_HS_CTRL_DATA_HDR_SZ + 1)
+#endif
+
+/** Leading space required to prepend the L2CAP B-frame and ACL headers. */
+#define BLE_HS_MBUF_L2CAP_LEADINGSPACE  \
+    (BLE_HS_MBUF_ACL_LEADINGSPACE + BLE_L2CAP_HDR_SZ)
+
 struct os_mbuf *ble_hs_mbuf_bare_pkt(void);
 struct os_mbuf *ble_hs_mbuf_acl_pkt(void);
 struct os_mbuf *ble_hs_mbuf_l2cap_pkt(void);
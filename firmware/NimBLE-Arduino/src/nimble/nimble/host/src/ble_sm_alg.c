@@ -639,34 +639,34 @@ mbedtls_gen_keypair(uint8_t *public_key, uint8_t *private_key)
     int rc = BLE_HS_EUNKNOWN;
     mbedtls_entropy_context entropy = {0};
     mbedtls_ctr_drbg_context ctr_drbg = {0};
+    /* Not the static keypair: with BLE_SM_SC_KEY_POOL_CNT this runs on the
+     * keygen task, concurrently with ble_sm_alg_gen_dhkey() using its group.
+     */
+    mbedtls_ecp_keypair kp;
 
 
     mbedtls_entropy_init(&entropy);
     mbedtls_ctr_drbg_init(&ctr_drbg);
-
-    /* Free the previously allocate keypair */
-    mbedtls_ecp_keypair_free(&keypair);
-
-    mbedtls_ecp_keypair_init(&keypair);
+    mbedtls_ecp_keypair_init(&kp);
 
     if (( rc = mbedtls_ctr_drbg_seed(&ctr_drbg, mbedtls_entropy_func, &entropy,
                                 NULL, 0)) != 0) {
         goto exit;
     }
 
-    if ((rc = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, &keypair,
+    if ((rc = mbedtls_ecp_gen_key(MBEDTLS_ECP_DP_SECP256R1, &kp,
                                   mbedtls_ctr_drbg_random, &ctr_drbg)) != 0) {
         goto exit;
     }
 
-    if (( rc = mbedtls_mpi_write_binary(&keypair.MBEDTLS_PRIVATE(d), private_key, 32)) != 0) {
+    if (( rc = mbedtls_mpi_write_binary(&kp.MBEDTLS_PRIVATE(d), private_key, 32)) != 0) {
         goto exit;
     }
 
     size_t olen = 0;
     uint8_t pub[65] = {0};
 
-    if ((rc = mbedtls_ecp_point_write_binary(&keypair.MBEDTLS_PRIVATE(grp), &keypair.MBEDTLS_PRIVATE(Q), MBEDTLS_ECP_PF_UNCOMPRESSED,
+    if ((rc = mbedtls_ecp_point_write_binary(&kp.MBEDTLS_PRIVATE(grp), &kp.MBEDTLS_PRIVATE(Q), MBEDTLS_ECP_PF_UNCOMPRESSED,
                                              &olen, pub, 65)) != 0) {
         goto exit;
     }
@@ -676,8 +676,8 @@ mbedtls_gen_keypair(uint8_t *public_key, uint8_t *private_key)
 exit:
     mbedtls_ctr_drbg_free( &ctr_drbg );
     mbedtls_entropy_free( &entropy );
+    mbedtls_ecp_keypair_free(&kp);
     if (rc != 0) {
-        mbedtls_ecp_keypair_free(&keypair);
         return BLE_HS_EUNKNOWN;
     }
 
@@ -216,6 +216,7 @@ struct ble_sm_dhkey_check {
 #define BLE_SM_PROC_F_AUTHENTICATED         0x08
 #define BLE_SM_PROC_F_SC                    0x10
 #define BLE_SM_PROC_F_BONDING               0x20
+#define BLE_SM_PROC_F_SC_KEY_HELD           0x40
 
 #define BLE_SM_KE_F_ENC_INFO                0x01
 #define BLE_SM_KE_F_MASTER_ID               0x02
@@ -360,6 +361,15 @@ bool ble_sm_sc_oob_data_check(struct ble_sm_proc *proc,
                               bool oob_data_remote_present);
 void ble_sm_sc_oob_confirm(struct ble_sm_proc *proc, struct ble_sm_result *res);
 void ble_sm_sc_init(void);
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+void ble_sm_sc_key_pool_fill(void);
+void ble_sm_sc_key_pool_deinit(void);
+void ble_sm_sc_proc_free(struct ble_sm_proc *proc);
+#else
+#define ble_sm_sc_key_pool_fill()
+#define ble_sm_sc_key_pool_deinit()
+#define ble_sm_sc_proc_free(proc)
+#endif
 #else
 #define ble_sm_sc_io_action(proc, action) (BLE_HS_ENOTSUP)
 #define ble_sm_sc_confirm_exec(proc, res)
@@ -370,6 +380,9 @@ void ble_sm_sc_init(void);
 #define ble_sm_sc_dhkey_check_exec(proc, res, arg)
 #define ble_sm_sc_dhkey_check_rx(conn_handle, op, om, res)
 #define ble_sm_sc_init()
+#define ble_sm_sc_key_pool_fill()
+#define ble_sm_sc_key_pool_deinit()
+#define ble_sm_sc_proc_free(proc)
 
 #endif
 
@@ -411,6 +424,8 @@ int ble_sm_init(void);
         BLE_HS_ENOTSUP
 
 #define ble_sm_init() 0
+#define ble_sm_sc_key_pool_fill()
+#define ble_sm_sc_key_pool_deinit()
 
 #define ble_sm_alg_encrypt(key, plaintext, enc_data) \
         BLE_HS_ENOTSUP
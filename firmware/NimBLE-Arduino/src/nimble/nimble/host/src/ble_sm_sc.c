@@ -24,6 +24,14 @@
 #include "ble_hs_priv.h"
 #include "ble_sm_priv.h"
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+#ifndef ESP_PLATFORM
+#error "BLE_SM_SC_KEY_POOL_CNT requires the FreeRTOS port"
+#endif
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
 #if NIMBLE_BLE_CONNECT
 #if MYNEWT_VAL(BLE_SM_SC)
 
@@ -39,6 +47,39 @@ static uint8_t ble_sm_sc_priv_key[32];
  */
 static uint8_t ble_sm_sc_keys_generated;
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+#define BLE_SM_SC_KEYGEN_STACK_SIZE 4096
+
+struct ble_sm_sc_key_pair {
+    uint8_t pub[64];
+    uint8_t priv[32];
+};
+
+/** Key pairs generated ahead of time by the keygen task. */
+static struct ble_sm_sc_key_pair
+    ble_sm_sc_key_pool[MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)];
+static uint8_t ble_sm_sc_key_pool_cnt;
+static TaskHandle_t ble_sm_sc_keygen_task_h;
+/** Set by deinit to stop the keygen task, set by the task once it exits. */
+static volatile uint8_t ble_sm_sc_keygen_stop;
+static volatile uint8_t ble_sm_sc_keygen_done;
+
+/**
+ * Number of procedures holding the current key pair and whether any pairing
+ * has used it yet.  A used pair is replaced as soon as nobody holds it, so
+ * every pairing attempt starts with a fresh key.
+ */
+static uint8_t ble_sm_sc_key_users;
+static uint8_t ble_sm_sc_key_spent;
+
+/**
+ * Whether OOB data computed over the current key pair is outstanding.  The
+ * OOB data counts as a user of the pair until an OOB pairing consumes it or
+ * new OOB data replaces it.
+ */
+static uint8_t ble_sm_sc_key_oob;
+#endif
+
 /**
  * Create some shortened names for the passkey actions so that the table is
  * easier to read.
@@ -172,10 +213,161 @@ ble_sm_gen_pub_priv(uint8_t *pub, uint8_t *priv)
     return 0;
 }
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+static int
+ble_sm_sc_key_pool_pop(uint8_t *pub, uint8_t *priv)
+{
+    struct ble_sm_sc_key_pair *kp;
+    os_sr_t sr;
+    int rc;
+
+    OS_ENTER_CRITICAL(sr);
+    if (ble_sm_sc_key_pool_cnt == 0) {
+        rc = BLE_HS_ENOENT;
+    } else {
+        kp = &ble_sm_sc_key_pool[--ble_sm_sc_key_pool_cnt];
+        memcpy(pub, kp->pub, sizeof kp->pub);
+        memcpy(priv, kp->priv, sizeof kp->priv);
+        memset(kp, 0, sizeof *kp);
+        rc = 0;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+/**
+ * Low priority task that tops up the key pool whenever it is notified, so
+ * the scalar multiplication never runs on the host task.
+ */
+static void
+ble_sm_sc_keygen_task(void *arg)
+{
+    struct ble_sm_sc_key_pair kp;
+    os_sr_t sr;
+    int full;
+
+    while (!ble_sm_sc_keygen_stop) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        full = 0;
+        while (!full && !ble_sm_sc_keygen_stop) {
+            if (ble_sm_alg_gen_key_pair(kp.pub, kp.priv) != 0) {
+                break;
+            }
+
+            OS_ENTER_CRITICAL(sr);
+            if (ble_sm_sc_key_pool_cnt < MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)) {
+                ble_sm_sc_key_pool[ble_sm_sc_key_pool_cnt++] = kp;
+            }
+            full = ble_sm_sc_key_pool_cnt >= MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT);
+            OS_EXIT_CRITICAL(sr);
+        }
+
+        memset(&kp, 0, sizeof kp);
+    }
+
+    ble_sm_sc_keygen_done = 1;
+    vTaskDelete(NULL);
+}
+
+void
+ble_sm_sc_key_pool_fill(void)
+{
+    if (ble_sm_sc_keygen_task_h == NULL) {
+        xTaskCreate(ble_sm_sc_keygen_task, "nimble_keygen",
+                    BLE_SM_SC_KEYGEN_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1,
+                    &ble_sm_sc_keygen_task_h);
+        if (ble_sm_sc_keygen_task_h == NULL) {
+            return;
+        }
+    }
+
+    xTaskNotifyGive(ble_sm_sc_keygen_task_h);
+}
+
+/**
+ * Stops the keygen task and wipes the pool.  The task is asked to exit and
+ * waited for rather than deleted, since it may be in the middle of an HCI
+ * command (the RNG of the key generation) and hold the HCI mutex.  Such a
+ * command ends at the latest with the HCI command timeout.
+ */
+void
+ble_sm_sc_key_pool_deinit(void)
+{
+    if (ble_sm_sc_keygen_task_h != NULL) {
+        ble_sm_sc_keygen_stop = 1;
+        xTaskNotifyGive(ble_sm_sc_keygen_task_h);
+
+        while (!ble_sm_sc_keygen_done) {
+            vTaskDelay(1);
+        }
+
+        ble_sm_sc_keygen_task_h = NULL;
+        ble_sm_sc_keygen_stop = 0;
+        ble_sm_sc_keygen_done = 0;
+    }
+
+    memset(ble_sm_sc_key_pool, 0, sizeof ble_sm_sc_key_pool);
+    ble_sm_sc_key_pool_cnt = 0;
+
+    memset(ble_sm_sc_priv_key, 0, sizeof ble_sm_sc_priv_key);
+    ble_sm_sc_keys_generated = 0;
+}
+
+static void
+ble_sm_sc_key_oob_release(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    if (ble_sm_sc_key_oob) {
+        BLE_HS_DBG_ASSERT(ble_sm_sc_key_users > 0);
+        ble_sm_sc_key_users--;
+        ble_sm_sc_key_oob = 0;
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+ble_sm_sc_proc_free(struct ble_sm_proc *proc)
+{
+    os_sr_t sr;
+
+    if (proc->flags & BLE_SM_PROC_F_SC_KEY_HELD) {
+        OS_ENTER_CRITICAL(sr);
+        BLE_HS_DBG_ASSERT(ble_sm_sc_key_users > 0);
+        ble_sm_sc_key_users--;
+        OS_EXIT_CRITICAL(sr);
+    }
+}
+#endif
+
+/**
+ * Makes sure our key pair is available.  If proc is not NULL, the procedure
+ * is registered as a user of the pair.
+ */
 static int
-ble_sm_sc_ensure_keys_generated(void)
+ble_sm_sc_ensure_keys_generated(struct ble_sm_proc *proc)
 {
     int rc;
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    if (ble_sm_sc_key_spent && ble_sm_sc_key_users == 0) {
+        ble_sm_sc_key_spent = 0;
+        ble_sm_sc_keys_generated = 0;
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    if (!ble_sm_sc_keys_generated) {
+        if (ble_sm_sc_key_pool_pop(ble_sm_sc_pub_key, ble_sm_sc_priv_key) == 0) {
+            ble_sm_sc_keys_generated = 1;
+        }
+        ble_sm_sc_key_pool_fill();
+    }
+#endif
 
     if (!ble_sm_sc_keys_generated) {
         rc = ble_sm_gen_pub_priv(ble_sm_sc_pub_key, ble_sm_sc_priv_key);
@@ -186,6 +378,17 @@ ble_sm_sc_ensure_keys_generated(void)
         ble_sm_sc_keys_generated = 1;
     }
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    if (proc != NULL && !(proc->flags & BLE_SM_PROC_F_SC_KEY_HELD)) {
+        proc->flags |= BLE_SM_PROC_F_SC_KEY_HELD;
+
+        OS_ENTER_CRITICAL(sr);
+        ble_sm_sc_key_users++;
+        ble_sm_sc_key_spent = 1;
+        OS_EXIT_CRITICAL(sr);
+    }
+#endif
+
     BLE_HS_LOG(DEBUG, "our pubkey=");
     ble_hs_log_flat_buf(&ble_sm_sc_pub_key, 64);
     BLE_HS_LOG(DEBUG, "\n");
@@ -540,13 +743,20 @@ ble_sm_sc_public_key_exec(struct ble_sm_proc *proc, struct ble_sm_result *res,
     uint8_t ioact;
     int rc;
 
-    res->app_status = ble_sm_sc_ensure_keys_generated();
+    res->app_status = ble_sm_sc_ensure_keys_generated(proc);
     if (res->app_status != 0) {
         res->enc_cb = 1;
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
         return;
     }
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    /* The procedure now holds the pair the OOB data was computed over. */
+    if (proc->pair_alg == BLE_SM_PAIR_ALG_OOB) {
+        ble_sm_sc_key_oob_release();
+    }
+#endif
+
     cmd = ble_sm_cmd_get(BLE_SM_OP_PAIR_PUBLIC_KEY, sizeof(*cmd), &txom);
     if (!cmd) {
         res->app_status = BLE_HS_ENOMEM;
@@ -604,7 +814,7 @@ ble_sm_sc_public_key_rx(uint16_t conn_handle, struct os_mbuf **om,
         return;
     }
 
-    res->app_status = ble_sm_sc_ensure_keys_generated();
+    res->app_status = ble_sm_sc_ensure_keys_generated(NULL);
     if (res->app_status != 0) {
         res->enc_cb = 1;
         res->sm_err = BLE_SM_ERR_UNSPECIFIED;
@@ -883,28 +1093,53 @@ int
 ble_sm_sc_oob_generate_data(struct ble_sm_sc_oob_data *oob_data)
 {
     int rc;
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    os_sr_t sr;
+#endif
 
 #if !MYNEWT_VAL(BLE_SM_SC)
     return BLE_HS_ENOTSUP;
 #endif
 
-    rc = ble_sm_sc_ensure_keys_generated();
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    /* New OOB data supersedes the previous one, which may let the pair
+     * rotate below.
+     */
+    ble_sm_sc_key_oob_release();
+#endif
+
+    rc = ble_sm_sc_ensure_keys_generated(NULL);
     if (rc) {
         return rc;
     }
 
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    /* Pin the pair until the OOB data is consumed. */
+    OS_ENTER_CRITICAL(sr);
+    ble_sm_sc_key_users++;
+    ble_sm_sc_key_spent = 1;
+    ble_sm_sc_key_oob = 1;
+    OS_EXIT_CRITICAL(sr);
+#endif
+
     rc = ble_hs_hci_util_rand(oob_data->r, 16);
     if (rc) {
-        return rc;
+        goto err;
     }
 
     rc = ble_sm_alg_f4(ble_sm_sc_pub_key, ble_sm_sc_pub_key, oob_data->r, 0,
                        oob_data->c);
     if (rc) {
-        return rc;
+        goto err;
     }
 
     return 0;
+
+err:
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    ble_sm_sc_key_oob_release();
+#endif
+    return rc;
 }
 
 void
@@ -912,6 +1147,11 @@ ble_sm_sc_init(void)
 {
     ble_sm_alg_ecc_init();
     ble_sm_sc_keys_generated = 0;
+#if MYNEWT_VAL(BLE_SM_SC_KEY_POOL_CNT)
+    ble_sm_sc_key_users = 0;
+    ble_sm_sc_key_spent = 0;
+    ble_sm_sc_key_oob = 0;
+#endif
 }
 
 #endif  /* MYNEWT_VAL(BLE_SM_SC) */
@@ -27,6 +27,7 @@
 #include "nimconfig.h"
 #define NIMBLE_CORE (CONFIG_BT_NIMBLE_PINNED_TO_CORE < portNUM_PROCESSORS ? CONFIG_BT_NIMBLE_PINNED_TO_CORE : tskNO_AFFINITY)
 #define NIMBLE_HS_STACK_SIZE CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE
+#define NIMBLE_HS_TASK_PRIO CONFIG_BT_NIMBLE_HOST_TASK_PRIORITY
 #else
 #include "../syscfg/syscfg.h"
 #define NIMBLE_HS_STACK_SIZE (CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE / 4)
@@ -81,6 +82,29 @@ int nimble_port_stop(void);
 
 struct ble_npl_eventq *nimble_port_get_dflt_eventq(void);
 
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+struct nimble_port_hs_stats {
+    /** Time covered by the figures below, in microseconds */
+    uint64_t period_us;
+    /** Time spent running event handlers, in microseconds */
+    uint64_t busy_us;
+    /** Number of events run */
+    uint32_t events;
+    /** Longest single event handler, in microseconds */
+    uint32_t max_event_us;
+    /** Most events run back to back without the queue running empty */
+    uint32_t max_burst;
+};
+
+/**
+ * @brief nimble_port_get_hs_stats - Read the host task dispatch statistics
+ *
+ * @param stats  Filled with the figures gathered since the last reset
+ * @param reset  Start a new measurement period if true
+ */
+void nimble_port_get_hs_stats(struct nimble_port_hs_stats *stats, bool reset);
+#endif
+
 #if NIMBLE_CFG_CONTROLLER
 void nimble_port_ll_task_func(void *arg);
 #endif
@@ -46,6 +46,18 @@ struct os_memblock {
     SLIST_ENTRY(os_memblock) mb_next;
 };
 
+/*
+ * The lock-free free list is only used if none of the mempool debug checks
+ * are enabled, since those rely on walking a stable SLIST of free blocks.
+ */
+#if MYNEWT_VAL(OS_MEMPOOL_LOCKFREE) && !SOC_ESP_NIMBLE_CONTROLLER && \
+    !MYNEWT_VAL(OS_MEMPOOL_CHECK) && !MYNEWT_VAL(OS_MEMPOOL_GUARD) && \
+    !MYNEWT_VAL(OS_MEMPOOL_POISON)
+#define OS_MEMPOOL_LOCKFREE     1
+#else
+#define OS_MEMPOOL_LOCKFREE     0
+#endif
+
 /* XXX: Change this structure so that we keep the first address in the pool? */
 /* XXX: add memory debug structure and associated code */
 /* XXX: Change how I coded the SLIST_HEAD here. It should be named:
@@ -69,6 +81,14 @@ struct os_mempool {
     uint32_t mp_membuf_addr;
     STAILQ_ENTRY(os_mempool) mp_list;
     SLIST_HEAD(,os_memblock);
+#if OS_MEMPOOL_LOCKFREE
+    /**
+     * Free list head used instead of the SLIST head; the low 16 bits hold
+     * the index of the first free block plus one (0 = empty), the upper 16
+     * bits a modification tag to avoid ABA races.
+     */
+    uint32_t mp_free_head;
+#endif
     /** Name for memory block */
     const char *name;
 };
@@ -58,6 +58,10 @@
 #endif
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+#include <string.h>
+#include "esp_timer.h"
+#endif
 
 #define NIMBLE_PORT_LOG_TAG          "BLE_INIT"
 
@@ -74,6 +78,12 @@ static struct ble_npl_eventq g_eventq_dflt;
 static struct ble_npl_sem ble_hs_stop_sem;
 static struct ble_npl_event ble_hs_ev_stop;
 
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+static portMUX_TYPE nimble_port_hs_stats_mux = portMUX_INITIALIZER_UNLOCKED;
+static struct nimble_port_hs_stats nimble_port_hs_stats;
+static int64_t nimble_port_hs_stats_start;
+#endif
+
 /**
  * Called when the host stop procedure has completed.
  */
@@ -313,10 +323,37 @@ void
 IRAM_ATTR nimble_port_run(void)
 {
     struct ble_npl_event *ev;
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+    uint32_t burst = 0;
+    int64_t start;
+    uint32_t dur;
+#endif
 
     while (1) {
         ev = ble_npl_eventq_get(&g_eventq_dflt, BLE_NPL_TIME_FOREVER);
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+        start = esp_timer_get_time();
+        ble_npl_event_run(ev);
+        dur = (uint32_t)(esp_timer_get_time() - start);
+
+        burst++;
+        portENTER_CRITICAL(&nimble_port_hs_stats_mux);
+        nimble_port_hs_stats.busy_us += dur;
+        nimble_port_hs_stats.events++;
+        if (dur > nimble_port_hs_stats.max_event_us) {
+            nimble_port_hs_stats.max_event_us = dur;
+        }
+        if (burst > nimble_port_hs_stats.max_burst) {
+            nimble_port_hs_stats.max_burst = burst;
+        }
+        portEXIT_CRITICAL(&nimble_port_hs_stats_mux);
+
+        if (ble_npl_eventq_is_empty(&g_eventq_dflt)) {
+            burst = 0;
+        }
+#else
         ble_npl_event_run(ev);
+#endif
         if (ev == &ble_hs_ev_stop) {
             break;
         }
@@ -324,6 +361,25 @@ IRAM_ATTR nimble_port_run(void)
     }
 }
 
+#if defined(ESP_PLATFORM) && CONFIG_BT_NIMBLE_HOST_TASK_STATS
+void
+nimble_port_get_hs_stats(struct nimble_port_hs_stats *stats, bool reset)
+{
+    int64_t now;
+
+    now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&nimble_port_hs_stats_mux);
+    *stats = nimble_port_hs_stats;
+    stats->period_us = now - nimble_port_hs_stats_start;
+    if (reset) {
+        memset(&nimble_port_hs_stats, 0, sizeof(nimble_port_hs_stats));
+        nimble_port_hs_stats_start = now;
+    }
+    portEXIT_CRITICAL(&nimble_port_hs_stats_mux);
+}
+#endif
+
 struct ble_npl_eventq *
 IRAM_ATTR nimble_port_get_dflt_eventq(void)
 {
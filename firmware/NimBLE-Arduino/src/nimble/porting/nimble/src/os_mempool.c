@@ -115,6 +115,62 @@ os_mempool_guard_check(const struct os_mempool *mp, void *start)
 #define os_mempool_guard(mp, start)
 #define os_mempool_guard_check(mp, start)
 #endif
+#if OS_MEMPOOL_LOCKFREE
+#define OS_MEMPOOL_HEAD_IDX_MASK    0x0000ffff
+#define OS_MEMPOOL_HEAD_TAG_INC     0x00010000
+
+static inline struct os_memblock *
+os_mempool_head_block(const struct os_mempool *mp, uint32_t head)
+{
+    uint32_t idx;
+
+    idx = head & OS_MEMPOOL_HEAD_IDX_MASK;
+    if (idx == 0) {
+        return NULL;
+    }
+
+    return (struct os_memblock *)(uintptr_t)
+           (mp->mp_membuf_addr + (idx - 1) * OS_MEMPOOL_TRUE_BLOCK_SIZE(mp));
+}
+
+/* Build the successor of head pointing to block, bumping the ABA tag. */
+static inline uint32_t
+os_mempool_head_next(const struct os_mempool *mp, uint32_t head,
+                     const struct os_memblock *block)
+{
+    uint32_t idx;
+
+    idx = 0;
+    if (block != NULL) {
+        idx = ((uint32_t)(uintptr_t)block - mp->mp_membuf_addr) /
+              OS_MEMPOOL_TRUE_BLOCK_SIZE(mp) + 1;
+    }
+
+    return ((head & ~OS_MEMPOOL_HEAD_IDX_MASK) + OS_MEMPOOL_HEAD_TAG_INC) | idx;
+}
+
+static inline void
+os_mempool_head_reset(struct os_mempool *mp)
+{
+    __atomic_store_n(&mp->mp_free_head, (mp->mp_num_blocks > 0) ? 1 : 0,
+                     __ATOMIC_RELEASE);
+}
+
+static void
+os_mempool_min_free_update(struct os_mempool *mp, uint16_t num_free)
+{
+    uint16_t min_free;
+
+    min_free = __atomic_load_n(&mp->mp_min_free, __ATOMIC_RELAXED);
+    while (num_free < min_free &&
+           !__atomic_compare_exchange_n(&mp->mp_min_free, &min_free, num_free,
+                                        true, __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+}
+#else
+#define os_mempool_head_reset(mp)
+#endif
 
 static os_error_t
 os_mempool_init_internal(struct os_mempool *mp, uint16_t blocks,
@@ -174,6 +230,7 @@ os_mempool_init_internal(struct os_mempool *mp, uint16_t blocks,
         SLIST_NEXT(block_ptr, mb_next) = NULL;
     }
 
+    os_mempool_head_reset(mp);
     STAILQ_INSERT_TAIL(&g_os_mempool_list, mp, mp_list);
 
     return OS_OK;
@@ -279,6 +336,7 @@ os_mempool_clear(struct os_mempool *mp)
 
     /* Last one in the list should be NULL */
     SLIST_NEXT(block_ptr, mb_next) = NULL;
+    os_mempool_head_reset(mp);
 
     return OS_OK;
 }
@@ -299,7 +357,12 @@ os_mempool_is_sane(const struct os_mempool *mp)
     struct os_memblock *block;
 
     /* Verify that each block in the free list belongs to the mempool. */
+#if OS_MEMPOOL_LOCKFREE
+    for (block = os_mempool_head_block(mp, mp->mp_free_head); block != NULL;
+         block = SLIST_NEXT(block, mb_next)) {
+#else
     SLIST_FOREACH(block, mp, mb_next) {
+#endif
         if (!os_memblock_from(mp, block)) {
             return false;
         }
@@ -337,6 +400,88 @@ os_memblock_from(const struct os_mempool *mp, const void *block_addr)
     return 1;
 }
 
+#if OS_MEMPOOL_LOCKFREE
+void *
+os_memblock_get(struct os_mempool *mp)
+{
+    struct os_memblock *block;
+    uint32_t head;
+    uint32_t next;
+    uint16_t num_free;
+
+    os_trace_api_u32(OS_TRACE_ID_MEMBLOCK_GET, (uint32_t)(uintptr_t)mp);
+
+    block = NULL;
+    if (mp) {
+        /* Reserve a block by decrementing the counter, which never exceeds
+         * the number of blocks on the list since puts increment it only once
+         * the block is linked. A successful reservation hence always finds a
+         * block to pop.
+         */
+        num_free = __atomic_load_n(&mp->mp_num_free, __ATOMIC_RELAXED);
+        do {
+            if (num_free == 0) {
+                goto out;
+            }
+        } while (!__atomic_compare_exchange_n(&mp->mp_num_free, &num_free,
+                                              num_free - 1, true,
+                                              __ATOMIC_ACQUIRE,
+                                              __ATOMIC_RELAXED));
+
+        os_mempool_min_free_update(mp, num_free - 1);
+
+        /* Pop the head. The next pointer of a block that has been taken by
+         * someone else in the meantime may be garbage, but then the tag has
+         * changed as well and the exchange fails.
+         */
+        head = __atomic_load_n(&mp->mp_free_head, __ATOMIC_ACQUIRE);
+        do {
+            block = os_mempool_head_block(mp, head);
+            assert(block != NULL);
+
+            next = os_mempool_head_next(mp, head,
+                        __atomic_load_n(&SLIST_NEXT(block, mb_next),
+                                        __ATOMIC_RELAXED));
+        } while (!__atomic_compare_exchange_n(&mp->mp_free_head, &head, next,
+                                              true, __ATOMIC_ACQUIRE,
+                                              __ATOMIC_ACQUIRE));
+    }
+
+out:
+    os_trace_api_ret_u32(OS_TRACE_ID_MEMBLOCK_GET, (uint32_t)(uintptr_t)block);
+
+    return (void *)block;
+}
+
+os_error_t
+os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr)
+{
+    struct os_memblock *block;
+    uint32_t head;
+    uint32_t next;
+
+    os_trace_api_u32x2(OS_TRACE_ID_MEMBLOCK_PUT_FROM_CB, (uint32_t)(uintptr_t)mp,
+                       (uint32_t)(uintptr_t)block_addr);
+
+    block = (struct os_memblock *)block_addr;
+
+    /* Chain current free list head to this block; make this block head */
+    head = __atomic_load_n(&mp->mp_free_head, __ATOMIC_RELAXED);
+    do {
+        SLIST_NEXT(block, mb_next) = os_mempool_head_block(mp, head);
+        next = os_mempool_head_next(mp, head, block);
+    } while (!__atomic_compare_exchange_n(&mp->mp_free_head, &head, next,
+                                          true, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
+
+    /* Only count the block once it can be popped, cf. os_memblock_get() */
+    __atomic_add_fetch(&mp->mp_num_free, 1, __ATOMIC_RELEASE);
+
+    os_trace_api_ret_u32(OS_TRACE_ID_MEMBLOCK_PUT_FROM_CB, (uint32_t)OS_OK);
+
+    return OS_OK;
+}
+#else
 void *
 os_memblock_get(struct os_mempool *mp)
 {
@@ -405,6 +550,7 @@ os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr)
 
     return OS_OK;
 }
+#endif
 
 os_error_t
 os_memblock_put(struct os_mempool *mp, void *block_addr)
@@ -446,14 +446,34 @@ struct ble_npl_event {
     bool queued;
     ble_npl_event_fn *fn;
     void *arg;
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+    struct ble_npl_event *next;
+    struct ble_npl_event *prev;
+#endif
 };
 
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+struct ble_npl_eventq {
+    /* Non-NULL once initialized, like the xQueue handle it replaces. */
+    void *q;
+    struct ble_npl_event *head;
+    struct ble_npl_event *tail;
+    /* Task blocked in ble_npl_eventq_get(), woken by task notification. */
+    TaskHandle_t waiter;
+};
+#else
 struct ble_npl_eventq {
     QueueHandle_t q;
 };
+#endif
 
 struct ble_npl_callout {
-#if CONFIG_BT_NIMBLE_USE_ESP_TIMER
+#if CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL
+    struct ble_npl_callout *wheel_next;
+    struct ble_npl_callout *wheel_prev;
+    ble_npl_time_t exp;
+    bool active;
+#elif CONFIG_BT_NIMBLE_USE_ESP_TIMER
    esp_timer_handle_t handle;
 #else
     TimerHandle_t handle;
@@ -493,13 +513,24 @@ ble_npl_get_current_task_id(void)
 static inline void
 ble_npl_eventq_init(struct ble_npl_eventq *evq)
 {
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+    evq->head = NULL;
+    evq->tail = NULL;
+    evq->waiter = NULL;
+    evq->q = evq;
+#else
     evq->q = xQueueCreate(NIMBLE_EVT_QUEUE_SIZE, sizeof(struct ble_npl_eventq *));
+#endif
 }
 
 static inline void
 ble_npl_eventq_deinit(struct ble_npl_eventq *evq)
 {
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+    evq->q = NULL;
+#else
     vQueueDelete(evq->q);
+#endif
 }
 
 static inline struct ble_npl_event *
@@ -529,7 +560,11 @@ ble_npl_event_run(struct ble_npl_event *ev)
 static inline bool
 ble_npl_eventq_is_empty(struct ble_npl_eventq *evq)
 {
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+    return evq->head == NULL;
+#else
     return xQueueIsQueueEmptyFromISR(evq->q);
+#endif
 }
 
 static inline void
@@ -46,6 +46,18 @@ esp_err_t esp_nimble_enable(void *host_task);
  * @return esp_err_t
  */
 esp_err_t esp_nimble_disable(void);
+
+/**
+ * @brief nimble_port_freertos_set_hs_task_cfg - Set core, priority and stack
+ *        size of the NimBLE host task, must be called before the task is created
+ *
+ * @param core        core to pin to, tskNO_AFFINITY to leave unpinned
+ * @param prio
+ * @param stack_size
+ * @return esp_err_t
+ */
+esp_err_t nimble_port_freertos_set_hs_task_cfg(BaseType_t core, UBaseType_t prio,
+                                               uint32_t stack_size);
 #endif
 
 void nimble_port_freertos_init(TaskFunction_t host_task_fn);
@@ -43,6 +43,12 @@ static StaticTask_t hs_xTaskBuffer;
 
 static TaskHandle_t host_task_h = NULL;
 
+#ifdef ESP_PLATFORM
+static BaseType_t hs_task_core = NIMBLE_CORE;
+static UBaseType_t hs_task_prio = NIMBLE_HS_TASK_PRIO;
+static uint32_t hs_task_stack_size = NIMBLE_HS_STACK_SIZE;
+#endif
+
 UBaseType_t nimble_port_freertos_get_hs_hwm(void) {
     if (host_task_h == NULL)
         return 0;
@@ -63,12 +69,41 @@ esp_err_t esp_nimble_enable(void *host_task)
      * have separate task for NimBLE host, but since something needs to handle
      * default queue it is just easier to make separate task which does this.
      */
-    xTaskCreatePinnedToCore(host_task, "nimble_host", NIMBLE_HS_STACK_SIZE,
-                            NULL, (configMAX_PRIORITIES - 4), &host_task_h, NIMBLE_CORE);
+    xTaskCreatePinnedToCore(host_task, "nimble_host", hs_task_stack_size,
+                            NULL, hs_task_prio, &host_task_h, hs_task_core);
     return ESP_OK;
 
 }
 
+/**
+ * @brief nimble_port_freertos_set_hs_task_cfg - Set core, priority and stack
+ *        size of the NimBLE host task
+ *
+ * Takes effect the next time the host task is created. Cores beyond the
+ * number available leave the task unpinned.
+ *
+ * @param core
+ * @param prio
+ * @param stack_size
+ * @return esp_err_t  ESP_ERR_INVALID_STATE if the host task is running
+ */
+esp_err_t nimble_port_freertos_set_hs_task_cfg(BaseType_t core, UBaseType_t prio,
+                                               uint32_t stack_size)
+{
+    if (host_task_h) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (prio >= configMAX_PRIORITIES || stack_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    hs_task_core = (core >= 0 && core < portNUM_PROCESSORS) ? core : tskNO_AFFINITY;
+    hs_task_prio = prio;
+    hs_task_stack_size = stack_size;
+    return ESP_OK;
+}
+
 /**
  * @brief esp_nimble_disable - Disable the NimBLE host
  *
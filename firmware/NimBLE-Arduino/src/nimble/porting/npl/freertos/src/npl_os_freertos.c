@@ -1346,15 +1346,26 @@ void npl_freertos_funcs_deinit(void)
 #include "freertos/portable.h"
 #include "esp_log.h"
 portMUX_TYPE ble_port_mutex = portMUX_INITIALIZER_UNLOCKED;
-#  if CONFIG_BT_NIMBLE_USE_ESP_TIMER
+#  if CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL
+#include "esp_timer.h"
+#  elif CONFIG_BT_NIMBLE_USE_ESP_TIMER
 static const char *LOG_TAG = "Timer";
 #  endif
+#  if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+#include "esp_attr.h"
+#  endif
 
 #else
 #include "nrf.h"
 static void *radio_isr_addr;
 static void *rng_isr_addr;
 static void *rtc0_isr_addr;
+#  if CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL
+#error "CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL requires esp_timer"
+#  endif
+#  if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+#error "CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ requires the ESP-IDF spinlock API"
+#  endif
 #endif
 
 #ifdef ESP_PLATFORM
@@ -1409,6 +1420,141 @@ npl_freertos_hw_set_isr(int irqn, void (*addr)(void))
 }
 #endif
 
+#if CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+/*
+ * Intrusive event queue: events are linked through their own next/prev
+ * pointers, so put and get are a few pointer updates in a critical section
+ * instead of a copy through a kernel queue.  The consumer sleeps on its task
+ * notification, which producers only signal while it is actually waiting.
+ */
+static portMUX_TYPE npl_evq_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static struct ble_npl_event *
+IRAM_ATTR npl_evq_pop(struct ble_npl_eventq *evq)
+{
+    struct ble_npl_event *ev;
+
+    ev = evq->head;
+    if (ev != NULL) {
+        evq->head = ev->next;
+        if (evq->head != NULL) {
+            evq->head->prev = NULL;
+        } else {
+            evq->tail = NULL;
+        }
+        ev->next = NULL;
+        ev->queued = false;
+    }
+
+    return ev;
+}
+
+struct ble_npl_event *
+IRAM_ATTR npl_freertos_eventq_get(struct ble_npl_eventq *evq, ble_npl_time_t tmo)
+{
+    struct ble_npl_event *ev;
+    TickType_t start = 0;
+    TickType_t elapsed;
+    TickType_t left;
+
+    left = tmo;
+    if (tmo != 0 && tmo != portMAX_DELAY) {
+        start = xTaskGetTickCount();
+    }
+
+    while (1) {
+        portENTER_CRITICAL_SAFE(&npl_evq_mux);
+        ev = npl_evq_pop(evq);
+        evq->waiter = (ev == NULL && left != 0) ? xTaskGetCurrentTaskHandle() :
+                                                  NULL;
+        portEXIT_CRITICAL_SAFE(&npl_evq_mux);
+
+        if (ev != NULL || left == 0) {
+            return ev;
+        }
+
+        assert(!in_isr());
+        ulTaskNotifyTake(pdTRUE, left);
+
+        /* A stale notification may end the wait early, keep waiting for the
+         * rest of the timeout.
+         */
+        if (tmo != portMAX_DELAY) {
+            elapsed = xTaskGetTickCount() - start;
+            left = (elapsed < tmo) ? tmo - elapsed : 0;
+        }
+    }
+}
+
+void
+IRAM_ATTR npl_freertos_eventq_put(struct ble_npl_eventq *evq, struct ble_npl_event *ev)
+{
+    TaskHandle_t waiter;
+    BaseType_t woken;
+
+    portENTER_CRITICAL_SAFE(&npl_evq_mux);
+
+    if (ev->queued) {
+        portEXIT_CRITICAL_SAFE(&npl_evq_mux);
+        return;
+    }
+
+    ev->queued = true;
+    ev->next = NULL;
+    ev->prev = evq->tail;
+    if (evq->tail != NULL) {
+        evq->tail->next = ev;
+    } else {
+        evq->head = ev;
+    }
+    evq->tail = ev;
+
+    waiter = evq->waiter;
+    evq->waiter = NULL;
+
+    portEXIT_CRITICAL_SAFE(&npl_evq_mux);
+
+    if (waiter == NULL) {
+        return;
+    }
+
+    if (in_isr()) {
+        woken = pdFALSE;
+        vTaskNotifyGiveFromISR(waiter, &woken);
+        if (woken == pdTRUE) {
+            portYIELD_FROM_ISR();
+        }
+    } else {
+        xTaskNotifyGive(waiter);
+    }
+}
+
+void
+IRAM_ATTR npl_freertos_eventq_remove(struct ble_npl_eventq *evq,
+                      struct ble_npl_event *ev)
+{
+    portENTER_CRITICAL_SAFE(&npl_evq_mux);
+
+    if (ev->queued) {
+        if (ev->prev != NULL) {
+            ev->prev->next = ev->next;
+        } else {
+            evq->head = ev->next;
+        }
+        if (ev->next != NULL) {
+            ev->next->prev = ev->prev;
+        } else {
+            evq->tail = ev->prev;
+        }
+
+        ev->next = NULL;
+        ev->prev = NULL;
+        ev->queued = false;
+    }
+
+    portEXIT_CRITICAL_SAFE(&npl_evq_mux);
+}
+#else
 struct ble_npl_event *
 npl_freertos_eventq_get(struct ble_npl_eventq *evq, ble_npl_time_t tmo)
 {
@@ -1540,6 +1686,7 @@ npl_freertos_eventq_remove(struct ble_npl_eventq *evq,
 
     ev->queued = 0;
 }
+#endif
 
 ble_npl_error_t
 npl_freertos_mutex_init(struct ble_npl_mutex *mu)
@@ -1695,6 +1842,306 @@ npl_freertos_sem_release(struct ble_npl_sem *sem)
 }
 
 
+#if CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL
+/*
+ * All callouts share a single hashed timer wheel driven by one esp_timer.
+ * Arming and stopping a callout only links or unlinks it from its wheel slot;
+ * the esp_timer is reprogrammed only when the earliest deadline moves forward.
+ * Each slot holds the callouts whose expiry tick maps to it, regardless of how
+ * many wheel revolutions away they are.
+ */
+#define NPL_WHEEL_SLOTS         (64)
+#define NPL_WHEEL_SLOT(t)       ((t) % NPL_WHEEL_SLOTS)
+
+static struct ble_npl_callout *npl_wheel[NPL_WHEEL_SLOTS];
+static portMUX_TYPE npl_wheel_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/* Next tick to be processed by the wheel. */
+static ble_npl_time_t npl_wheel_tick;
+static uint16_t npl_wheel_count;
+
+static esp_timer_handle_t npl_wheel_timer;
+static ble_npl_time_t npl_wheel_timer_exp;
+static bool npl_wheel_timer_armed;
+
+static void
+npl_wheel_link(struct ble_npl_callout *co)
+{
+    struct ble_npl_callout **slot = &npl_wheel[NPL_WHEEL_SLOT(co->exp)];
+
+    co->wheel_prev = NULL;
+    co->wheel_next = *slot;
+    if (*slot != NULL) {
+        (*slot)->wheel_prev = co;
+    }
+    *slot = co;
+
+    co->active = true;
+    npl_wheel_count++;
+}
+
+static void
+npl_wheel_unlink(struct ble_npl_callout *co)
+{
+    if (co->wheel_prev != NULL) {
+        co->wheel_prev->wheel_next = co->wheel_next;
+    } else {
+        npl_wheel[NPL_WHEEL_SLOT(co->exp)] = co->wheel_next;
+    }
+    if (co->wheel_next != NULL) {
+        co->wheel_next->wheel_prev = co->wheel_prev;
+    }
+
+    co->wheel_next = NULL;
+    co->wheel_prev = NULL;
+    co->active = false;
+    npl_wheel_count--;
+}
+
+/* Must be called with npl_wheel_mux held. */
+static void
+npl_wheel_timer_program(ble_npl_time_t exp, ble_npl_time_t now)
+{
+    int32_t ticks;
+
+    ticks = exp - now;
+    if (ticks < 1) {
+        ticks = 1;
+    }
+
+    esp_timer_stop(npl_wheel_timer);
+    esp_timer_start_once(npl_wheel_timer,
+                         (uint64_t)ticks * 1000000 / configTICK_RATE_HZ);
+
+    npl_wheel_timer_exp = exp;
+    npl_wheel_timer_armed = true;
+}
+
+/*
+ * Removes and returns one expired callout, advancing the wheel over the slots
+ * that have no expired entries left.  Must be called with npl_wheel_mux held.
+ */
+static struct ble_npl_callout *
+npl_wheel_pop_expired(ble_npl_time_t now)
+{
+    struct ble_npl_callout *co;
+
+    /* Every slot is visited at most once per call, however long the wheel was
+     * left idle.
+     */
+    if ((int32_t)(now - npl_wheel_tick) >= NPL_WHEEL_SLOTS) {
+        npl_wheel_tick = now - NPL_WHEEL_SLOTS + 1;
+    }
+
+    while ((int32_t)(now - npl_wheel_tick) >= 0) {
+        for (co = npl_wheel[NPL_WHEEL_SLOT(npl_wheel_tick)];
+             co != NULL;
+             co = co->wheel_next) {
+
+            if ((int32_t)(co->exp - now) <= 0) {
+                npl_wheel_unlink(co);
+                return co;
+            }
+        }
+
+        npl_wheel_tick++;
+    }
+
+    return NULL;
+}
+
+/*
+ * Finds the earliest deadline of all armed callouts.  Slots are checked in
+ * tick order for one revolution; callouts further out need a full walk.  Must
+ * be called with npl_wheel_mux held and at least one callout armed.
+ */
+static ble_npl_time_t
+npl_wheel_next_exp(void)
+{
+    struct ble_npl_callout *co;
+    ble_npl_time_t exp;
+    bool found;
+    int i;
+
+    for (i = 0; i < NPL_WHEEL_SLOTS; i++) {
+        for (co = npl_wheel[NPL_WHEEL_SLOT(npl_wheel_tick + i)];
+             co != NULL;
+             co = co->wheel_next) {
+
+            if ((int32_t)(co->exp - (npl_wheel_tick + i)) <= 0) {
+                return co->exp;
+            }
+        }
+    }
+
+    found = false;
+    exp = 0;
+    for (i = 0; i < NPL_WHEEL_SLOTS; i++) {
+        for (co = npl_wheel[i]; co != NULL; co = co->wheel_next) {
+            if (!found || (int32_t)(co->exp - exp) < 0) {
+                exp = co->exp;
+                found = true;
+            }
+        }
+    }
+
+    return exp;
+}
+
+static void
+npl_wheel_fire(struct ble_npl_callout *co)
+{
+    if (co->evq) {
+        ble_npl_eventq_put(co->evq, &co->ev);
+    } else {
+        co->ev.fn(&co->ev);
+    }
+}
+
+static void
+npl_wheel_timer_cb(void *arg)
+{
+    struct ble_npl_callout *co;
+    ble_npl_time_t now;
+
+    /* Expired callouts are taken off the wheel one at a time, since the event
+     * queue cannot be posted to from within the critical section.  All of them
+     * are delivered in this single timer dispatch.
+     */
+    while (1) {
+        now = ble_npl_time_get();
+
+        portENTER_CRITICAL_SAFE(&npl_wheel_mux);
+        co = npl_wheel_pop_expired(now);
+        if (co == NULL) {
+            npl_wheel_timer_armed = false;
+            if (npl_wheel_count > 0) {
+                npl_wheel_timer_program(npl_wheel_next_exp(), now);
+            }
+        }
+        portEXIT_CRITICAL_SAFE(&npl_wheel_mux);
+
+        if (co == NULL) {
+            break;
+        }
+
+        npl_wheel_fire(co);
+    }
+}
+
+void
+npl_freertos_callout_init(struct ble_npl_callout *co, struct ble_npl_eventq *evq,
+                          ble_npl_event_fn *ev_cb, void *ev_arg)
+{
+    if (npl_wheel_timer == NULL) {
+        esp_timer_create_args_t create_args = {
+          .callback = npl_wheel_timer_cb,
+          .arg = NULL,
+          .name = "nimble_wheel"
+        };
+
+        ESP_ERROR_CHECK(esp_timer_create(&create_args, &npl_wheel_timer));
+    }
+
+    npl_freertos_callout_stop(co);
+
+    co->evq = evq;
+    ble_npl_event_init(&co->ev, ev_cb, ev_arg);
+}
+
+void
+npl_freertos_callout_deinit(struct ble_npl_callout *co)
+{
+    npl_freertos_callout_stop(co);
+    memset(co, 0, sizeof(struct ble_npl_callout));
+}
+
+ble_npl_error_t
+npl_freertos_callout_reset(struct ble_npl_callout *co, ble_npl_time_t ticks)
+{
+    ble_npl_time_t now;
+
+    if (ticks == 0) {
+        ticks = 1;
+    }
+
+    now = ble_npl_time_get();
+
+    portENTER_CRITICAL_SAFE(&npl_wheel_mux);
+
+    if (co->active) {
+        npl_wheel_unlink(co);
+    }
+
+    if (npl_wheel_count == 0) {
+        /* The wheel was idle; nothing is pending behind the current tick. */
+        npl_wheel_tick = now;
+    }
+
+    co->exp = now + ticks;
+    npl_wheel_link(co);
+
+    if (!npl_wheel_timer_armed ||
+        (int32_t)(co->exp - npl_wheel_timer_exp) < 0) {
+
+        npl_wheel_timer_program(co->exp, now);
+    }
+
+    portEXIT_CRITICAL_SAFE(&npl_wheel_mux);
+
+    return BLE_NPL_OK;
+}
+
+void
+npl_freertos_callout_stop(struct ble_npl_callout *co)
+{
+    portENTER_CRITICAL_SAFE(&npl_wheel_mux);
+
+    if (co->active) {
+        npl_wheel_unlink(co);
+
+        /* An earlier deadline left programmed only causes one spurious
+         * wakeup; the timer is stopped once nothing is armed.
+         */
+        if (npl_wheel_count == 0 && npl_wheel_timer_armed) {
+            esp_timer_stop(npl_wheel_timer);
+            npl_wheel_timer_armed = false;
+        }
+    }
+
+    portEXIT_CRITICAL_SAFE(&npl_wheel_mux);
+}
+
+bool
+npl_freertos_callout_is_active(struct ble_npl_callout *co)
+{
+    return co->active;
+}
+
+ble_npl_time_t
+npl_freertos_callout_get_ticks(struct ble_npl_callout *co)
+{
+    return co->exp;
+}
+
+ble_npl_time_t
+npl_freertos_callout_remaining_ticks(struct ble_npl_callout *co,
+                                     ble_npl_time_t now)
+{
+    int32_t rt;
+
+    if (!co->active) {
+        return 0;
+    }
+
+    rt = co->exp - now;
+    if (rt < 0) {
+        rt = 0;
+    }
+
+    return rt;
+}
+#else
 #if CONFIG_BT_NIMBLE_USE_ESP_TIMER
 static void
 ble_npl_event_fn_wrapper(void *arg)
@@ -1907,6 +2354,7 @@ npl_freertos_callout_remaining_ticks(struct ble_npl_callout *co,
 
     return rt;
 }
+#endif
 
 ble_npl_error_t
 npl_freertos_time_ms_to_ticks(uint32_t ms, ble_npl_time_t *out_ticks)
@@ -139,12 +139,98 @@
 /** @brief Un-comment to change the stack size for the NimBLE host task */
 // #define CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE 4096
 
+/**
+ * @brief Un-comment to change the FreeRTOS priority of the NimBLE host task
+ * @details the core, priority and stack size can also be changed at runtime
+ * with nimble_port_freertos_set_hs_task_cfg() before NimBLEDevice::init().
+ */
+// #define CONFIG_BT_NIMBLE_HOST_TASK_PRIORITY (configMAX_PRIORITIES - 4)
+
 /**
  * @brief Un-comment to use memory pools for stack operations
  * @details this will use slightly more RAM but may provide more stability.
  */
 // #define CONFIG_NIMBLE_STACK_USE_MEM_POOLS 1
 
+/**
+ * @brief Un-comment to use a lock-free free list for the memory pools
+ * @details os_memblock_get/put then use a compare-and-swap instead of a critical section.\n
+ * The critical section version is kept if any of the mempool debug checks are enabled.\n
+ * Only useful on targets with native atomics (ESP32, ESP32-S3). The ESP32-C3 core has no
+ * atomic instructions, every __atomic_* operation is a library call that masks interrupts,
+ * so a get or put costs several critical sections instead of one.
+ */
+// #define CONFIG_BT_NIMBLE_MEMPOOL_LOCKFREE 1
+
+/**
+ * @brief Un-comment to deliver HCI events to the host task in batches
+ * @details Events received from the controller are queued in a ring and a single host event
+ * drains all of them, instead of posting one event per HCI packet.
+ */
+// #define CONFIG_BT_NIMBLE_HCI_EVT_BATCH 1
+
+/**
+ * @brief Un-comment to cache ATT service discovery responses
+ * @details Sets the number of Find Information / Read By Type / Read By Group Type responses
+ * kept, so reconnecting hosts are answered without walking the attribute table again.
+ */
+// #define CONFIG_BT_NIMBLE_ATT_DISC_CACHE_COUNT 16
+
+/**
+ * @brief Un-comment to run all NimBLE timers from a single timer wheel
+ * @details Arming and stopping a timer become list operations instead of commands to the\n
+ * FreeRTOS timer task. Only used when CONFIG_NIMBLE_STACK_USE_MEM_POOLS is disabled.
+ */
+// #define CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL 1
+
+/**
+ * @brief Un-comment to use an intrusive linked list for the NimBLE event queues
+ * @details Events are linked in place and the host task is woken by task notification,\n
+ * instead of copying event pointers through a FreeRTOS queue.\n
+ * Only used when CONFIG_NIMBLE_STACK_USE_MEM_POOLS is disabled.
+ */
+// #define CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ 1
+
+/**
+ * @brief Un-comment to have the host task record how much time it spends
+ * dispatching events and how many events it runs back to back.\n
+ * Read the figures with nimble_port_get_hs_stats().
+ */
+// #define CONFIG_BT_NIMBLE_HOST_TASK_STATS 1
+
+/**
+ * @brief Un-comment to use mbedtls instead of tinycrypt for security manager and mesh crypto.
+ * @details mbedtls uses a precomputed comb for P-256 key generation and the AES hardware,
+ * which shortens LE Secure Connections pairing at the cost of flash.
+ */
+// #define CONFIG_BT_NIMBLE_CRYPTO_STACK_MBEDTLS 1
+
+/**
+ * @brief Un-comment to generate LE Secure Connections key pairs ahead of time in a
+ * low priority task and keep this many ready, so pairing never waits on ECC.\n
+ * A key pair is used for one pairing attempt only.
+ */
+// #define CONFIG_BT_NIMBLE_SM_SC_KEY_POOL_COUNT 2
+
+/**
+ * @brief Sets the number of characteristics that can be given a notification TX
+ * policy with ble_gatts_set_tx_policy() (priority queueing and/or replacing
+ * stale queued values on a congested link). 0 removes the feature.
+ */
+// #define CONFIG_BT_NIMBLE_GATTS_TX_POLICY_COUNT 4
+
+/**
+ * @brief Un-comment to remove the connection event hook, ble_gap_conn_event_hook_set(),
+ * which calls the application shortly before each predicted connection event.
+ */
+// #define CONFIG_BT_NIMBLE_CONN_EVENT_HOOK 0
+
+/**
+ * @brief Sets the number of expanded AES key schedules the mesh crypto glue keeps
+ * for its long lived keys. 0 expands the key for every block.
+ */
+// #define CONFIG_BT_NIMBLE_MESH_KEY_SCHED_CACHE_SIZE 4
+
 /**********************************
  End Arduino user-config
 **********************************/
@@ -174,6 +260,10 @@
 #define CONFIG_BT_NIMBLE_HOST_TASK_STACK_SIZE 4096
 #endif
 
+#ifndef CONFIG_BT_NIMBLE_HOST_TASK_PRIORITY
+#define CONFIG_BT_NIMBLE_HOST_TASK_PRIORITY (configMAX_PRIORITIES - 4)
+#endif
+
 #ifndef CONFIG_BT_NIMBLE_MEM_ALLOC_MODE_EXTERNAL
 #define CONFIG_BT_NIMBLE_MEM_ALLOC_MODE_INTERNAL 1
 #endif
@@ -218,6 +308,50 @@
 #define CONFIG_NIMBLE_STACK_USE_MEM_POOLS 0
 #endif
 
+#ifndef CONFIG_BT_NIMBLE_MEMPOOL_LOCKFREE
+#define CONFIG_BT_NIMBLE_MEMPOOL_LOCKFREE 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_HCI_EVT_BATCH
+#define CONFIG_BT_NIMBLE_HCI_EVT_BATCH 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_ATT_DISC_CACHE_COUNT
+#define CONFIG_BT_NIMBLE_ATT_DISC_CACHE_COUNT 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL
+#define CONFIG_BT_NIMBLE_NPL_TIMER_WHEEL 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ
+#define CONFIG_BT_NIMBLE_NPL_INTRUSIVE_EVQ 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_HOST_TASK_STATS
+#define CONFIG_BT_NIMBLE_HOST_TASK_STATS 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_CRYPTO_STACK_MBEDTLS
+#define CONFIG_BT_NIMBLE_CRYPTO_STACK_MBEDTLS 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_SM_SC_KEY_POOL_COUNT
+#define CONFIG_BT_NIMBLE_SM_SC_KEY_POOL_COUNT 0
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_GATTS_TX_POLICY_COUNT
+#define CONFIG_BT_NIMBLE_GATTS_TX_POLICY_COUNT 4
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_CONN_EVENT_HOOK
+#define CONFIG_BT_NIMBLE_CONN_EVENT_HOOK 1
+#endif
+
+#ifndef CONFIG_BT_NIMBLE_MESH_KEY_SCHED_CACHE_SIZE
+#define CONFIG_BT_NIMBLE_MESH_KEY_SCHED_CACHE_SIZE 4
+#endif
+
 /** @brief Set if CCCD's and bond data should be stored in NVS */
 #define CONFIG_BT_NIMBLE_NVS_PERSIST 1
 
@@ -187,6 +187,15 @@ void BleKeyboard::begin(void)
   advertising->start();
   hid->setBatteryLevel(batteryLevel);
 
+  // when the link backs up, input reports overtake queued traffic and only the
+  // latest battery level is kept; priority reports stay in order among each
+  // other, so relative mouse reports are neither reordered nor overtaken by
+  // key reports
+  ble_gatts_set_tx_policy(inputKeyboard->getHandle(), BLE_GATTS_TX_F_PRIO);
+  ble_gatts_set_tx_policy(inputMediaKeys->getHandle(), BLE_GATTS_TX_F_PRIO);
+  ble_gatts_set_tx_policy(inputMouse->getHandle(), BLE_GATTS_TX_F_PRIO);
+  ble_gatts_set_tx_policy(hid->batteryLevel()->getHandle(), BLE_GATTS_TX_F_LATEST);
+
   ESP_LOGD(LOG_TAG, "Advertising started!");
 }
 
@@ -218,6 +227,23 @@ void BleKeyboard::setDelay(uint32_t ms) {
   this->_delay_ms = ms;
 }
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+// Call cb lead_us before connection events of the next connection, starting
+// with the event following a call to kickConnEventHook() and for as long as cb
+// returns nonzero. The hook is dropped by the host once that connection
+// terminates and re-registered on the next connect.
+void BleKeyboard::setConnEventHook(ble_gap_conn_event_fn* cb, void* arg, uint32_t lead_us) {
+  this->connEventCb = cb;
+  this->connEventArg = arg;
+  this->connEventLead = lead_us;
+}
+
+void BleKeyboard::kickConnEventHook(void) {
+  if(this->connected)
+    ble_gap_conn_event_hook_kick(this->connHandle);
+}
+#endif
+
 void BleKeyboard::set_vendor_id(uint16_t vid) { 
 	this->vid = vid; 
 }
@@ -544,6 +570,15 @@ void BleKeyboard::onConnect(BLEServer* pServer) {
   this->connected = true;
 }
 
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+void BleKeyboard::onConnect(BLEServer* pServer, ble_gap_conn_desc* desc) {
+  this->connHandle = desc->conn_handle;
+
+  if(this->connEventCb != nullptr)
+    ble_gap_conn_event_hook_set(desc->conn_handle, this->connEventLead, this->connEventCb, this->connEventArg);
+}
+#endif
+
 void BleKeyboard::onDisconnect(BLEServer* pServer) {
   this->connected = false;
 }
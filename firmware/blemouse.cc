@@ -16,38 +16,117 @@
 
 
 
+#include <config.h>
 #include <firmware/blemouse.h>
 
+// With a report lead time configured, motion is only accumulated by move() and
+// sent right before the next connection event, so the peer gets the freshest
+// sum instead of a report that waited in the queue for most of an interval.
+// The connection event hook is only armed while there is motion pending.
+// Button changes are still reported immediately.
+#if CONFIG_FW_MOUSE_REPORT_LEAD > 0 && MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+#define DEFER_MOTION
+#endif
+
+void BleMouse::begin(void)
+{
+#ifdef DEFER_MOTION
+  _keyboard->setConnEventHook(connEvent, this, CONFIG_FW_MOUSE_REPORT_LEAD);
+#endif
+}
+
+#ifdef DEFER_MOTION
+int BleMouse::connEvent(uint16_t conn_handle, void* arg)
+{
+  return ((BleMouse*)arg)->report(false);
+}
+#endif
+
 void BleMouse::click(uint8_t b)
 {
-  _buttons = b;
-  move(0,0,0,0);
-  _buttons = 0;
-  move(0,0,0,0);
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _buttons = b;
+  }
+
+  report(true);
+
+  {
+    std::lock_guard<std::mutex> lock(_lock);
+    _buttons = 0;
+  }
+
+  report(true);
 }
 
 void BleMouse::move(signed char x, signed char y, signed char wheel, signed char hWheel)
 {
   if (_keyboard->isConnected())
   {
-    uint8_t m[5];
-    m[0] = _buttons;
-    m[1] = x;
-    m[2] = y;
-    m[3] = wheel;
-    m[4] = hWheel;
-    _keyboard->inputMouse->setValue(m, 5);
-    _keyboard->inputMouse->notify();
+    {
+      std::lock_guard<std::mutex> lock(_lock);
+      _x += x;
+      _y += y;
+      _wheel += wheel;
+      _hWheel += hWheel;
+    }
+
+#ifdef DEFER_MOTION
+    _keyboard->kickConnEventHook();
+#else
+    report(false);
+#endif
+  }
+}
+
+static signed char take(int* v)
+{
+  int r = (*v < -127) ? -127 : ((*v > 127) ? 127 : *v);
+
+  *v -= r;
+  return r;
+}
+
+// Send the buttons and the accumulated motion, if any or if forced. Motion
+// beyond the range of a single report is carried over to the next one.
+// Returns whether there is motion left to report.
+bool BleMouse::report(bool force)
+{
+  std::lock_guard<std::mutex> lock(_lock);
+  uint8_t m[5];
+
+  if (!_keyboard->isConnected())
+  {
+    _x = _y = _wheel = _hWheel = 0;
+    return false;
   }
+
+  if (!force && _x == 0 && _y == 0 && _wheel == 0 && _hWheel == 0)
+    return false;
+
+  m[0] = _buttons;
+  m[1] = take(&_x);
+  m[2] = take(&_y);
+  m[3] = take(&_wheel);
+  m[4] = take(&_hWheel);
+  _keyboard->inputMouse->setValue(m, 5);
+  _keyboard->inputMouse->notify();
+
+  return _x != 0 || _y != 0 || _wheel != 0 || _hWheel != 0;
 }
 
 void BleMouse::buttons(uint8_t b)
 {
-  if (b != _buttons)
   {
+    std::lock_guard<std::mutex> lock(_lock);
+
+    if (b == _buttons)
+      return;
+
     _buttons = b;
-    move(0,0,0,0);
   }
+
+  report(true);
 }
 
 void BleMouse::press(uint8_t b)
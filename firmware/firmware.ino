@@ -267,7 +267,7 @@ static uint8_t read(void){
 
 
 #ifdef CONFIG_UART_MODE_USB_JTAG
-	while(usb_serial_jtag_read_bytes(&c, 1, 0) != 1);
+	while(usb_serial_jtag_read_bytes(&c, 1, portMAX_DELAY) != 1);
 #else
 	while(Serial.readBytes((uint8_t*)&c, 1) != 1);
 #endif // CONFIG_UART_MODE_SERIAL
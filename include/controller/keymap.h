@@ -0,0 +1,14 @@
+#ifndef KEYMAP_H
+#define KEYMAP_H
+
+
+#include <stdint.h>
+#include <X11/X.h>
+
+
+/* prototypes */
+void keymap_init(void);
+uint8_t keymap_translate(KeySym sym);
+
+
+#endif // KEYMAP_H
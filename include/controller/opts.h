@@ -9,7 +9,12 @@
 typedef struct{
 	bool debug,
 		 log_to_stdout,
-		 reverse_custom_xkb_map;
+		 reverse_custom_xkb_map,
+		 no_x;
+
+	char const *record,
+			   *replay;
+	double replay_speed;
 } opts_t;
 
 
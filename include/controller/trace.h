@@ -0,0 +1,52 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <controller/uart.h>
+#include <controller/xlib.h>
+
+
+/* macros */
+#define TRACE_MAGIC		"BMBT"
+#define TRACE_VERSION	1
+
+
+/* types */
+// trace files are a trace_hdr_t followed by trace_rec_t records,
+// both stored in host byte order
+typedef struct{
+	char magic[4];
+	uint16_t version;
+	uint16_t rec_size;
+} trace_hdr_t;
+
+typedef struct{
+	uint32_t dt;		// time since the previous record [us]
+	uint8_t type;		// X event type
+	uint8_t code;		// key: keycode, button: button number
+	int8_t dx,			// motion: movement sent to the device
+		   dy;
+	int16_t x,			// motion, enter: pointer position, configure: window size
+			y;
+	uint32_t keysym;	// key: keysym of the keycode
+} trace_rec_t;
+
+typedef struct{
+	FILE *fp;
+	struct timespec last;
+} trace_t;
+
+
+/* prototypes */
+trace_t *trace_open(char const *file, bool replay);
+void trace_close(trace_t *trace);
+
+int trace_record(trace_t *trace, xevent_t *ev, xlib_obj_t *xobj);
+int trace_replay(trace_t *trace, double speed, xlib_obj_t *xobj, uart_t *uart);
+
+
+#endif // TRACE_H
@@ -149,6 +149,12 @@ private:
   uint8_t            batteryLevel;
   bool               connected = false;
   uint32_t           _delay_ms = 7;
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+  ble_gap_conn_event_fn* connEventCb = nullptr;
+  void*              connEventArg = nullptr;
+  uint32_t           connEventLead = 0;
+  uint16_t           connHandle = BLE_HS_CONN_HANDLE_NONE;
+#endif
   void delay_ms(uint64_t ms);
 
   uint16_t vid       = 0x05ac;
@@ -173,6 +179,10 @@ public:
   void setBatteryLevel(uint8_t level);
   void setName(std::string deviceName);  
   void setDelay(uint32_t ms);
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+  void setConnEventHook(ble_gap_conn_event_fn* cb, void* arg, uint32_t lead_us);
+  void kickConnEventHook(void);
+#endif
 
   void set_vendor_id(uint16_t vid);
   void set_product_id(uint16_t pid);
@@ -182,6 +192,9 @@ public:
 protected:
   virtual void onStarted(BLEServer *pServer) { };
   virtual void onConnect(BLEServer* pServer) override;
+#if MYNEWT_VAL(BLE_GAP_CONN_EVENT_HOOK)
+  virtual void onConnect(BLEServer* pServer, ble_gap_conn_desc* desc) override;
+#endif
   virtual void onDisconnect(BLEServer* pServer) override;
   virtual void onWrite(BLECharacteristic* me) override;
 
@@ -19,6 +19,7 @@
 #ifndef ESP32_BLE_COMBO_MOUSE_H
 #define ESP32_BLE_COMBO_MOUSE_H
 #include <firmware/blekeyboard.h>
+#include <mutex>
 
 #define MOUSE_LEFT 1
 #define MOUSE_RIGHT 2
@@ -31,10 +32,14 @@ class BleMouse {
 private:
   BleKeyboard* _keyboard;
   uint8_t _buttons;
+  int _x = 0, _y = 0, _wheel = 0, _hWheel = 0; // motion not yet reported
+  std::mutex _lock;
   void buttons(uint8_t b);
+  bool report(bool force);
+  static int connEvent(uint16_t conn_handle, void* arg);
 public:
   BleMouse(BleKeyboard* keyboard) { _keyboard = keyboard; };
-  void begin(void) {};
+  void begin(void);
   void end(void) {};
   void click(uint8_t b = MOUSE_LEFT);
   void move(signed char x, signed char y, signed char wheel = 0, signed char hWheel = 0);
@@ -0,0 +1,127 @@
+// Benchmark of the ATT server attribute lookups and of complete ATT requests,
+// received through the loopback HCI transport and answered by the host.
+#include "npl.h"
+#include "hs.h"
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#include "nimble/nimble/host/src/ble_att_priv.h"
+#include "nimble/porting/nimble/include/os/endian.h"
+
+
+/* macros */
+#define LOOKUPS				200000
+#define REQUESTS			100000
+
+#define ATT_OP_READ_TYPE_REQ	0x08
+#define ATT_OP_READ_TYPE_RSP	0x09
+#define ATT_OP_READ_REQ			0x0a
+#define ATT_OP_READ_RSP			0x0b
+
+
+/* local/static prototypes */
+static int bench_find_by_handle(void);
+static int bench_find_by_uuid(void);
+static int bench_read(void);
+static int bench_read_type(void);
+
+
+/* global functions */
+int main(int argc, char **argv){
+	CHECK(hs_init() == 0);
+	CHECK(hs_connect() == 0);
+
+	if(bench_find_by_handle() != 0
+	|| bench_find_by_uuid() != 0
+	|| bench_read() != 0
+	|| bench_read_type() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench_find_by_handle(void){
+	// the battery level is the last characteristic, followed by its cccd
+	uint16_t last = hs.battery + 1;
+	uint64_t start;
+
+
+	CHECK(ble_att_svr_find_by_handle(last) != 0x0);
+	CHECK(ble_att_svr_find_by_handle(last + 1) == 0x0);
+
+	start = hs_time_ns();
+
+	for(size_t i=0; i<LOOKUPS; i++){
+		if(ble_att_svr_find_by_handle(1 + i % last) == 0x0)
+			CHECK(0);
+	}
+
+	hs_result("att find by handle", start, LOOKUPS);
+
+	return 0;
+}
+
+static int bench_find_by_uuid(void){
+	struct ble_att_svr_entry *entry;
+	size_t n = 0;
+	uint64_t start;
+
+
+	start = hs_time_ns();
+
+	// walk all hid reports, like a read by type request does
+	for(size_t i=0; i<LOOKUPS; i++){
+		entry = 0x0;
+
+		while((entry = ble_att_svr_find_by_uuid(entry, BLE_UUID16_DECLARE(0x2a4d), 0xffff)) != 0x0)
+			n++;
+	}
+
+	hs_result("att find by uuid, all reports", start, LOOKUPS);
+
+	CHECK(n == LOOKUPS * (HS_REPORTS + 1));
+
+	return 0;
+}
+
+static int bench_read(void){
+	uint8_t req[3];
+	uint64_t start;
+
+
+	req[0] = ATT_OP_READ_REQ;
+	put_le16(req + 1, hs.report_map);
+
+	start = hs_time_ns();
+
+	for(size_t i=0; i<REQUESTS; i++)
+		CHECK(hs_att_req(req, sizeof(req), ATT_OP_READ_RSP) == 0);
+
+	hs_result("att read request", start, REQUESTS);
+
+	// the report map exceeds the default mtu
+	CHECK(hci_stats.len == BLE_ATT_MTU_DFLT);
+
+	return 0;
+}
+
+static int bench_read_type(void){
+	uint8_t req[7];
+	uint64_t start;
+
+
+	req[0] = ATT_OP_READ_TYPE_REQ;
+	put_le16(req + 1, 0x1);
+	put_le16(req + 3, 0xffff);
+	put_le16(req + 5, 0x2a4d);
+
+	start = hs_time_ns();
+
+	for(size_t i=0; i<REQUESTS; i++)
+		CHECK(hs_att_req(req, sizeof(req), ATT_OP_READ_TYPE_RSP) == 0);
+
+	hs_result("att read by type request", start, REQUESTS);
+
+	return 0;
+}
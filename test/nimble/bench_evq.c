@@ -0,0 +1,493 @@
+// Benchmark of the intrusive event queue of the FreeRTOS NPL port against the
+// xQueue based one, cf. npl_os_freertos.c. The port cannot be built on the host,
+// hence both queues are replicated on top of a small pthread model of the used
+// FreeRTOS primitives:
+//	- xQueue: ring buffer copying the items under a mutex, with blocked
+//	  receivers waiting on a condition variable
+//	- task notification: counting semaphore per task
+//	- portENTER_CRITICAL_SAFE: spinlock, like the portMUX_TYPE of ESP-IDF
+// The absolute numbers hence only indicate the relative cost of both variants.
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define EVENTS			1000000
+#define ROUNDTRIPS		100000
+#define PENDING			8
+#define QUEUE_SIZE		32		// cf. NIMBLE_EVT_QUEUE_SIZE
+
+#define WAIT_FOREVER	(~0u)
+
+
+/* types */
+typedef struct event_t{
+	bool queued;
+	struct event_t *next,
+				   *prev;
+} event_t;
+
+typedef struct{
+	sem_t sem;
+} task_t;
+
+// model of an xQueue of event pointers
+typedef struct{
+	pthread_mutex_t mtx;
+	pthread_cond_t rx;
+
+	void *items[QUEUE_SIZE];
+	size_t item_size;
+	size_t rd,
+		   n;
+} xqueue_t;
+
+typedef struct{
+	event_t *head,
+			*tail;
+	task_t *waiter;
+} ievq_t;
+
+typedef struct{
+	xqueue_t *xq[2];
+	ievq_t *iq[2];
+	event_t *ev;
+} pingpong_t;
+
+
+/* local/static prototypes */
+static int bench_put_get(void);
+static int bench_remove(void);
+static int bench_wakeup(void);
+
+static void *pong_xqueue(void *arg);
+static void *pong_intrusive(void *arg);
+
+// xQueue model
+static void xqueue_init(xqueue_t *q);
+static void xqueue_send(xqueue_t *q, void const *item);
+static bool xqueue_receive(xqueue_t *q, void *item, unsigned int tmo);
+static size_t xqueue_waiting(xqueue_t *q);
+
+// event queue on top of the xQueue, cf. npl_freertos_eventq_*()
+static event_t *xevq_get(xqueue_t *q, unsigned int tmo);
+static void xevq_put(xqueue_t *q, event_t *ev);
+static void xevq_remove(xqueue_t *q, event_t *ev);
+
+// intrusive event queue, cf. npl_freertos_eventq_*()
+static event_t *ievq_pop(ievq_t *q);
+static event_t *ievq_get(ievq_t *q, unsigned int tmo);
+static void ievq_put(ievq_t *q, event_t *ev);
+static void ievq_remove(ievq_t *q, event_t *ev);
+
+static void critical_enter(void);
+static void critical_exit(void);
+
+static uint64_t time_ns(void);
+static void result(char const *name, uint64_t start, size_t n);
+
+
+/* static variables */
+static pthread_spinlock_t evq_mux;
+static __thread task_t task;
+
+
+/* global functions */
+int main(int argc, char **argv){
+	pthread_spin_init(&evq_mux, PTHREAD_PROCESS_PRIVATE);
+	sem_init(&task.sem, 0, 0);
+
+	if(bench_put_get() != 0
+	|| bench_remove() != 0
+	|| bench_wakeup() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench_put_get(void){
+	event_t ev[PENDING] = { 0 };
+	xqueue_t xq;
+	ievq_t iq = { 0 };
+	uint64_t start;
+
+
+	xqueue_init(&xq);
+
+	// a few events pending at a time, like the host task draining its queue
+	start = time_ns();
+
+	for(size_t i=0; i<EVENTS; i+=PENDING){
+		for(size_t j=0; j<PENDING; j++)
+			xevq_put(&xq, ev + j);
+
+		for(size_t j=0; j<PENDING; j++)
+			CHECK(xevq_get(&xq, 0) == ev + j);
+	}
+
+	result("evq put/get, xqueue", start, EVENTS);
+
+	start = time_ns();
+
+	for(size_t i=0; i<EVENTS; i+=PENDING){
+		for(size_t j=0; j<PENDING; j++)
+			ievq_put(&iq, ev + j);
+
+		for(size_t j=0; j<PENDING; j++)
+			CHECK(ievq_get(&iq, 0) == ev + j);
+	}
+
+	result("evq put/get, intrusive", start, EVENTS);
+
+	CHECK(xevq_get(&xq, 0) == 0x0);
+	CHECK(ievq_get(&iq, 0) == 0x0);
+
+	return 0;
+}
+
+static int bench_remove(void){
+	event_t xev[PENDING] = { 0 },
+			iev[PENDING] = { 0 };
+	event_t *rm;
+	xqueue_t xq;
+	ievq_t iq = { 0 };
+	uint64_t start;
+
+
+	xqueue_init(&xq);
+
+	for(size_t j=0; j<PENDING; j++){
+		xevq_put(&xq, xev + j);
+		ievq_put(&iq, iev + j);
+	}
+
+	// removal of a pending event, e.g. a stopped callout, and putting it back
+	start = time_ns();
+
+	for(size_t i=0; i<EVENTS / PENDING; i++){
+		rm = xev + i % PENDING;
+
+		xevq_remove(&xq, rm);
+		CHECK(!rm->queued);
+		xevq_put(&xq, rm);
+	}
+
+	result("evq remove, xqueue", start, EVENTS / PENDING);
+
+	start = time_ns();
+
+	for(size_t i=0; i<EVENTS / PENDING; i++){
+		rm = iev + i % PENDING;
+
+		ievq_remove(&iq, rm);
+		CHECK(!rm->queued);
+		ievq_put(&iq, rm);
+	}
+
+	result("evq remove, intrusive", start, EVENTS / PENDING);
+
+	for(size_t j=0; j<PENDING; j++){
+		CHECK(xevq_get(&xq, 0) != 0x0);
+		CHECK(ievq_get(&iq, 0) != 0x0);
+	}
+
+	CHECK(xevq_get(&xq, 0) == 0x0);
+	CHECK(ievq_get(&iq, 0) == 0x0);
+
+	return 0;
+}
+
+static int bench_wakeup(void){
+	event_t ev = { 0 };
+	xqueue_t xq[2];
+	ievq_t iq[2] = { 0 };
+	pingpong_t pp = { .xq = { xq, xq + 1 }, .iq = { iq, iq + 1 }, .ev = &ev };
+	pthread_t pong;
+	uint64_t start;
+
+
+	xqueue_init(xq);
+	xqueue_init(xq + 1);
+
+	// one event bounced between two tasks, each blocking in the get
+	CHECK(pthread_create(&pong, 0x0, pong_xqueue, &pp) == 0);
+
+	start = time_ns();
+
+	for(size_t i=0; i<ROUNDTRIPS; i++){
+		xevq_put(xq, &ev);
+		CHECK(xevq_get(xq + 1, WAIT_FOREVER) == &ev);
+	}
+
+	result("evq wakeup roundtrip, xqueue", start, ROUNDTRIPS);
+
+	xevq_put(xq, 0x0);
+	pthread_join(pong, 0x0);
+
+	CHECK(pthread_create(&pong, 0x0, pong_intrusive, &pp) == 0);
+
+	start = time_ns();
+
+	for(size_t i=0; i<ROUNDTRIPS; i++){
+		ievq_put(iq, &ev);
+		CHECK(ievq_get(iq + 1, WAIT_FOREVER) == &ev);
+	}
+
+	result("evq wakeup roundtrip, intrusive", start, ROUNDTRIPS);
+
+	ievq_put(iq, &(event_t){ 0 });
+	pthread_join(pong, 0x0);
+
+	return 0;
+}
+
+static void *pong_xqueue(void *arg){
+	pingpong_t *pp = arg;
+	event_t *ev;
+
+
+	while(1){
+		// a null event pointer terminates
+		ev = xevq_get(pp->xq[0], WAIT_FOREVER);
+
+		if(ev == 0x0)
+			return 0x0;
+
+		xevq_put(pp->xq[1], ev);
+	}
+}
+
+static void *pong_intrusive(void *arg){
+	pingpong_t *pp = arg;
+	event_t *ev;
+
+
+	sem_init(&task.sem, 0, 0);
+
+	while(1){
+		// any other event terminates
+		ev = ievq_get(pp->iq[0], WAIT_FOREVER);
+
+		if(ev != pp->ev)
+			return 0x0;
+
+		ievq_put(pp->iq[1], ev);
+	}
+}
+
+static void xqueue_init(xqueue_t *q){
+	memset(q, 0, sizeof(*q));
+	pthread_mutex_init(&q->mtx, 0x0);
+	pthread_cond_init(&q->rx, 0x0);
+	q->item_size = sizeof(event_t*);
+}
+
+static void xqueue_send(xqueue_t *q, void const *item){
+	pthread_mutex_lock(&q->mtx);
+
+	// the queue is sized for all events, hence never blocks
+	memcpy(q->items + (q->rd + q->n) % QUEUE_SIZE, item, q->item_size);
+	q->n++;
+
+	pthread_cond_signal(&q->rx);
+	pthread_mutex_unlock(&q->mtx);
+}
+
+static bool xqueue_receive(xqueue_t *q, void *item, unsigned int tmo){
+	pthread_mutex_lock(&q->mtx);
+
+	while(q->n == 0 && tmo != 0)
+		pthread_cond_wait(&q->rx, &q->mtx);
+
+	if(q->n == 0){
+		pthread_mutex_unlock(&q->mtx);
+
+		return false;
+	}
+
+	memcpy(item, q->items + q->rd, q->item_size);
+	q->rd = (q->rd + 1) % QUEUE_SIZE;
+	q->n--;
+
+	pthread_mutex_unlock(&q->mtx);
+
+	return true;
+}
+
+static size_t xqueue_waiting(xqueue_t *q){
+	size_t n;
+
+
+	pthread_mutex_lock(&q->mtx);
+	n = q->n;
+	pthread_mutex_unlock(&q->mtx);
+
+	return n;
+}
+
+static event_t *xevq_get(xqueue_t *q, unsigned int tmo){
+	event_t *ev = 0x0;
+
+
+	xqueue_receive(q, &ev, tmo);
+
+	if(ev != 0x0)
+		ev->queued = false;
+
+	return ev;
+}
+
+static void xevq_put(xqueue_t *q, event_t *ev){
+	if(ev != 0x0 && ev->queued)
+		return;
+
+	if(ev != 0x0)
+		ev->queued = true;
+
+	xqueue_send(q, &ev);
+}
+
+static void xevq_remove(xqueue_t *q, event_t *ev){
+	event_t *tmp;
+	size_t n;
+
+
+	if(!ev->queued)
+		return;
+
+	// drain the queue and put back all other events
+	n = xqueue_waiting(q);
+
+	for(size_t i=0; i<n; i++){
+		xqueue_receive(q, &tmp, 0);
+
+		if(tmp != ev)
+			xqueue_send(q, &tmp);
+	}
+
+	ev->queued = false;
+}
+
+static event_t *ievq_pop(ievq_t *q){
+	event_t *ev;
+
+
+	ev = q->head;
+
+	if(ev != 0x0){
+		q->head = ev->next;
+
+		if(q->head != 0x0)	q->head->prev = 0x0;
+		else				q->tail = 0x0;
+
+		ev->next = 0x0;
+		ev->queued = false;
+	}
+
+	return ev;
+}
+
+static event_t *ievq_get(ievq_t *q, unsigned int tmo){
+	event_t *ev;
+
+
+	while(1){
+		critical_enter();
+		ev = ievq_pop(q);
+		q->waiter = (ev == 0x0 && tmo != 0) ? &task : 0x0;
+		critical_exit();
+
+		if(ev != 0x0 || tmo == 0)
+			return ev;
+
+		// ulTaskNotifyTake(pdTRUE, portMAX_DELAY)
+		sem_wait(&task.sem);
+
+		while(sem_trywait(&task.sem) == 0);
+	}
+}
+
+static void ievq_put(ievq_t *q, event_t *ev){
+	task_t *waiter;
+
+
+	critical_enter();
+
+	if(ev->queued){
+		critical_exit();
+
+		return;
+	}
+
+	ev->queued = true;
+	ev->next = 0x0;
+	ev->prev = q->tail;
+
+	if(q->tail != 0x0)	q->tail->next = ev;
+	else				q->head = ev;
+
+	q->tail = ev;
+
+	waiter = q->waiter;
+	q->waiter = 0x0;
+
+	critical_exit();
+
+	// xTaskNotifyGive()
+	if(waiter != 0x0)
+		sem_post(&waiter->sem);
+}
+
+static void ievq_remove(ievq_t *q, event_t *ev){
+	critical_enter();
+
+	if(ev->queued){
+		if(ev->prev != 0x0)	ev->prev->next = ev->next;
+		else				q->head = ev->next;
+
+		if(ev->next != 0x0)	ev->next->prev = ev->prev;
+		else				q->tail = ev->prev;
+
+		ev->next = 0x0;
+		ev->prev = 0x0;
+		ev->queued = false;
+	}
+
+	critical_exit();
+}
+
+static void critical_enter(void){
+	pthread_spin_lock(&evq_mux);
+}
+
+static void critical_exit(void){
+	pthread_spin_unlock(&evq_mux);
+}
+
+static uint64_t time_ns(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void result(char const *name, uint64_t start, size_t n){
+	printf("%-32s %10.1f ns/op\n", name, (double)(time_ns() - start) / n);
+}
@@ -0,0 +1,112 @@
+// Benchmark of the msys mbuf operations on the host data path, with the mbuf
+// pools configured as in the firmware.
+#include <string.h>
+#include "npl.h"
+#include "hs.h"
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#include "nimble/porting/nimble/include/os/os_mbuf.h"
+
+
+/* macros */
+#define ITERATIONS		1000000
+#define REPORT_SIZE		8
+#define PACKET_SIZE		512
+
+
+/* local/static prototypes */
+static int bench_get(void);
+static int bench_report(void);
+static int bench_chain(void);
+
+
+/* global functions */
+int main(int argc, char **argv){
+	CHECK(hs_init() == 0);
+
+	if(bench_get() != 0
+	|| bench_report() != 0
+	|| bench_chain() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench_get(void){
+	int msys_free = os_msys_num_free();
+	struct os_mbuf *om;
+	uint64_t start;
+
+
+	start = hs_time_ns();
+
+	for(size_t i=0; i<ITERATIONS; i++){
+		om = os_msys_get_pkthdr(0, 0);
+
+		CHECK(om != 0x0);
+		os_mbuf_free_chain(om);
+	}
+
+	hs_result("msys get and free", start, ITERATIONS);
+
+	CHECK(os_msys_num_free() == msys_free);
+
+	return 0;
+}
+
+static int bench_report(void){
+	uint8_t report[REPORT_SIZE] = { 0 };
+	int msys_free = os_msys_num_free();
+	struct os_mbuf *om;
+	uint64_t start;
+
+
+	start = hs_time_ns();
+
+	// cf. NimBLECharacteristic::notify()
+	for(size_t i=0; i<ITERATIONS; i++){
+		report[0] = i;
+		om = ble_hs_mbuf_att_value_from_flat(report, sizeof(report));
+
+		CHECK(om != 0x0);
+		CHECK(os_mbuf_prepend(om, 3) != 0x0);
+		os_mbuf_free_chain(om);
+	}
+
+	hs_result("att value from flat, prepend", start, ITERATIONS);
+
+	CHECK(os_msys_num_free() == msys_free);
+
+	return 0;
+}
+
+static int bench_chain(void){
+	uint8_t data[PACKET_SIZE] = { 0 };
+	uint8_t out[PACKET_SIZE];
+	int msys_free = os_msys_num_free();
+	struct os_mbuf *om;
+	uint64_t start;
+
+
+	start = hs_time_ns();
+
+	// packets exceeding a single msys block
+	for(size_t i=0; i<ITERATIONS; i++){
+		data[i % PACKET_SIZE] = i;
+		om = os_msys_get_pkthdr(0, 0);
+
+		CHECK(om != 0x0);
+		CHECK(os_mbuf_append(om, data, sizeof(data)) == 0);
+		CHECK(os_mbuf_copydata(om, 0, sizeof(out), out) == 0);
+		os_mbuf_free_chain(om);
+	}
+
+	hs_result("msys chain append and copy", start, ITERATIONS);
+
+	CHECK(memcmp(data, out, sizeof(data)) == 0);
+	CHECK(os_msys_num_free() == msys_free);
+
+	return 0;
+}
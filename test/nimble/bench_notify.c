@@ -0,0 +1,81 @@
+// Benchmark of the notification path of the host, from ble_gatts_notify_custom()
+// down to the HCI transport, with the loopback controller completing the ACL
+// packets once per connection event.
+#include "npl.h"
+#include "hs.h"
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#include "nimble/nimble/host/include/host/ble_gatt.h"
+
+
+/* macros */
+#define NOTIFICATIONS	200000
+#define REPORT_SIZE		8
+
+#define ATT_OP_NOTIFY	0x1b
+
+
+/* local/static prototypes */
+static int bench(char const *name, size_t burst);
+
+
+/* global functions */
+int main(int argc, char **argv){
+	CHECK(hs_init() == 0);
+	CHECK(hs_connect() == 0);
+
+	for(size_t i=0; i<HS_REPORTS; i++)
+		CHECK(hs_subscribe(hs.report[i]) == 0);
+
+	// bursts fitting into the controller buffers are sent right away, full
+	// bursts are queued by the host until the next connection event
+	if(bench("notify, 1 per conn event", 1) != 0
+	|| bench("notify, 3 per conn event", HS_REPORTS) != 0
+	|| bench("notify, queued by the host", HCI_ACL_PACKETS) != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench(char const *name, size_t burst){
+	uint8_t report[REPORT_SIZE] = { 0 };
+	size_t n = NOTIFICATIONS / burst * burst;
+	size_t acl_pkts = hci_stats.acl_pkts;
+	size_t msys_free = os_msys_num_free();
+	struct os_mbuf *om;
+	uint64_t start;
+
+
+	start = hs_time_ns();
+
+	for(size_t i=0; i<n; i+=burst){
+		for(size_t j=0; j<burst; j++){
+			// cf. NimBLECharacteristic::notify()
+			report[0] = i + j;
+			om = ble_hs_mbuf_att_value_from_flat(report, sizeof(report));
+
+			CHECK(om != 0x0);
+			CHECK(ble_gatts_notify_custom(hs.conn, hs.report[j % HS_REPORTS], om) == 0);
+		}
+
+		// connection events until the host sent everything
+		while(hci_stats.acl_pkts - acl_pkts < i + burst){
+			hci_conn_event();
+			hs_run();
+		}
+	}
+
+	hs_result(name, start, n);
+
+	hci_conn_event();
+	hs_run();
+
+	CHECK(hci_stats.acl_pkts - acl_pkts == n);
+	CHECK(hci_stats.pdu[0] == ATT_OP_NOTIFY);
+	CHECK(hci_stats.len == 3 + REPORT_SIZE);
+	CHECK(os_msys_num_free() == msys_free);
+
+	return 0;
+}
@@ -0,0 +1,374 @@
+// Benchmark of the goodput of the mesh segmentation and reassembly (SAR) under
+// simulated segment loss, cf. transport.c. The mesh transport depends on the
+// whole mesh stack and the advertising bearer, hence this is a discrete event
+// model in 1 ms steps of the rules transport.c applies:
+//	- the sender queues all unacked segments per attempt and arms the
+//	  retransmit timer once the last queued one was sent
+//	- the receiver arms the ack timer on the first segment, acks a complete
+//	  SDU right away and otherwise whenever the ack timer expires
+//	- acks are heard through several relays, i.e. in several copies
+// Both the fixed ack timing and the adaptive one, which follows the segment
+// arrival, drops repeated acks and pulls the ack in at the last segment, are
+// simulated with the same random sequence.
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define SDUS				500
+#define SEGS				16		// segments per sdu
+#define SEG_LEN				12		// access payload per segment
+
+#define TTL					7		// cf. BLE_MESH_DEFAULT_TTL
+#define ATTEMPTS			4		// cf. BLE_MESH_SEG_RETRANSMIT_ATTEMPTS
+#define RETRANSMIT_TIMEOUT	(400 + 50 * TTL)	// cf. SEG_RETRANSMIT_TIMEOUT_UNICAST
+#define SEG_TX_TIME			50		// one segment on air incl. network transmits
+#define RELAYS				3		// copies of each ack heard by the sender
+#define RELAY_DELAY			10
+
+#define INTERVAL_MIN		20		// cf. SEG_RX_INTERVAL_MIN
+#define INTERVAL_MAX		100		// cf. SEG_RX_INTERVAL_MAX
+
+#define QUEUE_SIZE			256
+#define ACKS_MAX			32
+#define TIME_MAX			60000	// cf. the incomplete timer
+
+#define COMPLETE			((1u << SEGS) - 1)
+#define NONE				(~0u)
+
+
+/* types */
+typedef struct{
+	uint32_t at,
+			 block;
+} ack_t;
+
+typedef struct{
+	bool adaptive;
+	unsigned int loss;		// percent
+
+	uint32_t now;
+
+	// sender
+	uint32_t nack;
+	uint8_t queue[QUEUE_SIZE];
+	size_t rd,
+		   n;
+	uint32_t tx_done;
+	size_t seg_pending;
+	uint32_t retransmit;
+	unsigned int attempts;
+	bool failed;
+
+	// receiver
+	uint32_t block;
+	uint32_t interval;
+	uint32_t last;
+	uint32_t ack_timer;
+
+	// acks on their way to the sender
+	ack_t acks[ACKS_MAX];
+	size_t nacks;
+
+	size_t segs_sent;
+} sim_t;
+
+
+/* local/static prototypes */
+static int bench(unsigned int loss);
+static int run(sim_t *sim, size_t *delivered, uint32_t *time, size_t *segs);
+
+static void tx_send_unacked(sim_t *sim);
+static void tx_sent(sim_t *sim);
+static void tx_ack(sim_t *sim, uint32_t block);
+
+static void rx_seg(sim_t *sim, unsigned int seg);
+static void rx_send_ack(sim_t *sim);
+static uint32_t rx_ack_timeout(sim_t *sim);
+
+static bool lost(sim_t *sim);
+static unsigned int popcount(uint32_t v);
+
+
+/* static variables */
+static uint64_t rng_state;
+
+
+/* global functions */
+int main(int argc, char **argv){
+	if(bench(0) != 0
+	|| bench(10) != 0
+	|| bench(20) != 0
+	|| bench(30) != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench(unsigned int loss){
+	sim_t sim;
+	size_t delivered[2],
+		   segs[2];
+	uint32_t time[2];
+	char name[64];
+
+
+	for(size_t i=0; i<2; i++){
+		sim = (sim_t){ .adaptive = i, .loss = loss };
+
+		CHECK(run(&sim, delivered + i, time + i, segs + i) == 0);
+
+		snprintf(name, sizeof(name), "sar %s, %u%% loss", i ? "adaptive ack" : "fixed ack", loss);
+		printf("%-32s %10.1f B/s, %5.1f segments/sdu, %zu/%d sdus\n",
+			name,
+			(double)delivered[i] * SEGS * SEG_LEN * 1000 / time[i],
+			(double)segs[i] / SDUS,
+			delivered[i],
+			SDUS
+		);
+	}
+
+	// without loss both timings behave the same
+	if(loss == 0){
+		CHECK(delivered[0] == SDUS && delivered[1] == SDUS);
+		CHECK(time[0] == time[1]);
+	}
+
+	return 0;
+}
+
+static int run(sim_t *sim, size_t *delivered, uint32_t *time, size_t *segs){
+	uint32_t start;
+
+
+	// the same random sequence for both variants
+	rng_state = 0x123456789abcdef;
+
+	*delivered = 0;
+	*segs = 0;
+	sim->now = 0;
+
+	for(size_t i=0; i<SDUS; i++){
+		start = sim->now;
+
+		sim->nack = COMPLETE;
+		sim->rd = sim->n = 0;
+		sim->tx_done = NONE;
+		sim->seg_pending = 0;
+		sim->retransmit = NONE;
+		sim->attempts = ATTEMPTS + 1;
+		sim->failed = false;
+
+		sim->block = 0;
+		sim->interval = 0;
+		sim->last = 0;
+		sim->ack_timer = NONE;
+		sim->nacks = 0;
+		sim->segs_sent = 0;
+
+		tx_send_unacked(sim);
+
+		while(sim->nack != 0 && !sim->failed){
+			CHECK(sim->now - start < TIME_MAX);
+
+			// segment transmission
+			if(sim->tx_done == sim->now){
+				sim->tx_done = NONE;
+				tx_sent(sim);
+			}
+
+			if(sim->tx_done == NONE && sim->n != 0)
+				sim->tx_done = sim->now + SEG_TX_TIME;
+
+			// receiver ack timer
+			if(sim->ack_timer == sim->now){
+				rx_send_ack(sim);
+				sim->ack_timer = sim->now + rx_ack_timeout(sim);
+			}
+
+			// acks reaching the sender
+			for(size_t j=0; j<sim->nacks; j++){
+				if(sim->acks[j].at != sim->now)
+					continue;
+
+				tx_ack(sim, sim->acks[j].block);
+				sim->acks[j--] = sim->acks[--sim->nacks];
+			}
+
+			// sender retransmit timer
+			if(sim->retransmit == sim->now){
+				sim->retransmit = NONE;
+				tx_send_unacked(sim);
+			}
+
+			sim->now++;
+		}
+
+		// the adv buffers still queued are sent before the next sdu
+		sim->now += sim->n * SEG_TX_TIME;
+
+		*delivered += !sim->failed;
+		*segs += sim->segs_sent + sim->n;
+	}
+
+	*time = sim->now;
+
+	return 0;
+}
+
+static void tx_send_unacked(sim_t *sim){
+	// cf. seg_tx_send_unacked()
+	if(sim->nack == 0)
+		return;
+
+	if(--sim->attempts == 0){
+		sim->failed = true;
+		return;
+	}
+
+	for(unsigned int i=0; i<SEGS; i++){
+		if((sim->nack & (1u << i)) == 0 || sim->n == QUEUE_SIZE)
+			continue;
+
+		sim->queue[(sim->rd + sim->n++) % QUEUE_SIZE] = i;
+		sim->seg_pending++;
+	}
+}
+
+static void tx_sent(sim_t *sim){
+	unsigned int seg;
+
+
+	seg = sim->queue[sim->rd];
+	sim->rd = (sim->rd + 1) % QUEUE_SIZE;
+	sim->n--;
+	sim->segs_sent++;
+
+	if(!lost(sim))
+		rx_seg(sim, seg);
+
+	// cf. schedule_retransmit()
+	if(sim->nack == 0 || --sim->seg_pending != 0)
+		return;
+
+	sim->retransmit = sim->now + RETRANSMIT_TIMEOUT;
+}
+
+static void tx_ack(sim_t *sim, uint32_t block){
+	bool progress;
+
+
+	// cf. trans_ack()
+	if(sim->nack == 0)
+		return;
+
+	progress = (sim->nack & block) != 0;
+	sim->nack &= ~block;
+
+	if(sim->adaptive && !progress && sim->seg_pending)
+		return;
+
+	sim->retransmit = NONE;
+
+	if(sim->nack != 0)
+		tx_send_unacked(sim);
+}
+
+static void rx_seg(sim_t *sim, unsigned int seg){
+	uint32_t delta,
+			 timeout;
+
+
+	// cf. trans_seg(), a complete sdu is acked on every further segment
+	if(sim->block == COMPLETE){
+		rx_send_ack(sim);
+		return;
+	}
+
+	if(sim->adaptive && sim->block){
+		delta = sim->now - sim->last;
+
+		if(delta > INTERVAL_MAX)
+			delta = INTERVAL_MAX;
+
+		sim->interval = sim->interval ? (3 * sim->interval + delta) / 4 : delta;
+	}
+
+	sim->last = sim->now;
+
+	if(sim->ack_timer == NONE)
+		sim->ack_timer = sim->now + rx_ack_timeout(sim);
+
+	sim->block |= 1u << seg;
+
+	if(sim->block == COMPLETE){
+		sim->ack_timer = NONE;
+		rx_send_ack(sim);
+
+		return;
+	}
+
+	if(sim->adaptive && seg == SEGS - 1){
+		timeout = rx_ack_timeout(sim);
+
+		if(sim->ack_timer - sim->now > timeout)
+			sim->ack_timer = sim->now + timeout;
+	}
+}
+
+static void rx_send_ack(sim_t *sim){
+	for(size_t i=0; i<RELAYS && sim->nacks < ACKS_MAX; i++){
+		if(lost(sim))
+			continue;
+
+		sim->acks[sim->nacks++] = (ack_t){
+			.at = sim->now + SEG_TX_TIME + i * RELAY_DELAY,
+			.block = sim->block,
+		};
+	}
+}
+
+static uint32_t rx_ack_timeout(sim_t *sim){
+	uint32_t per_seg,
+			 to;
+
+
+	// cf. ack_timeout()
+	to = 150 + 50 * TTL;
+	per_seg = INTERVAL_MAX;
+
+	if(sim->adaptive && sim->interval){
+		per_seg = 2 * sim->interval;
+		per_seg = per_seg < INTERVAL_MIN ? INTERVAL_MIN : per_seg;
+		per_seg = per_seg > INTERVAL_MAX ? INTERVAL_MAX : per_seg;
+	}
+
+	to += (SEGS - popcount(sim->block)) * per_seg;
+
+	return to < 400 ? 400 : to;
+}
+
+static bool lost(sim_t *sim){
+	// xorshift64, reproducible losses
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+
+	return rng_state % 100 < sim->loss;
+}
+
+static unsigned int popcount(uint32_t v){
+	return __builtin_popcount(v);
+}
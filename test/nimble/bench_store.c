@@ -0,0 +1,121 @@
+// Benchmark of the RAM bond store, i.e. the security material and cccd lookups
+// done for every connection and subscription.
+#include <string.h>
+#include "npl.h"
+#include "hs.h"
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#include "nimble/nimble/host/include/host/ble_store.h"
+
+
+/* macros */
+#define ITERATIONS	200000
+
+#define BONDS		MYNEWT_VAL(BLE_STORE_MAX_BONDS)
+#define CCCDS		MYNEWT_VAL(BLE_STORE_MAX_CCCDS)
+
+
+/* local/static prototypes */
+static int bench_sec(void);
+static int bench_cccd(void);
+
+static void peer_addr(ble_addr_t *addr, size_t peer);
+
+
+/* global functions */
+int main(int argc, char **argv){
+	CHECK(hs_init() == 0);
+
+	if(bench_sec() != 0
+	|| bench_cccd() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int bench_sec(void){
+	struct ble_store_value_sec value;
+	struct ble_store_key_sec key;
+	uint64_t start;
+
+
+	memset(&value, 0, sizeof(value));
+	value.key_size = 16;
+	value.ltk_present = 1;
+
+	start = hs_time_ns();
+
+	// rewriting the bonds in turn, the store has to stay at its capacity
+	for(size_t i=0; i<ITERATIONS; i++){
+		peer_addr(&value.peer_addr, i % BONDS);
+		value.ltk[0] = i;
+
+		CHECK(ble_store_write_our_sec(&value) == 0);
+	}
+
+	hs_result("store write our sec", start, ITERATIONS);
+
+	memset(&key, 0, sizeof(key));
+	start = hs_time_ns();
+
+	for(size_t i=0; i<ITERATIONS; i++){
+		peer_addr(&key.peer_addr, i % BONDS);
+
+		CHECK(ble_store_read_our_sec(&key, &value) == 0);
+	}
+
+	hs_result("store read our sec", start, ITERATIONS);
+
+	CHECK(value.ltk[0] == (uint8_t)(ITERATIONS - 1));
+
+	peer_addr(&key.peer_addr, BONDS);
+	CHECK(ble_store_read_our_sec(&key, &value) == BLE_HS_ENOENT);
+
+	return 0;
+}
+
+static int bench_cccd(void){
+	struct ble_store_value_cccd value;
+	struct ble_store_key_cccd key;
+	uint64_t start;
+
+
+	memset(&value, 0, sizeof(value));
+	value.flags = 0x1;
+
+	start = hs_time_ns();
+
+	// one peer subscribed to all cccds
+	for(size_t i=0; i<ITERATIONS; i++){
+		peer_addr(&value.peer_addr, 0);
+		value.chr_val_handle = 1 + i % CCCDS;
+
+		CHECK(ble_store_write_cccd(&value) == 0);
+	}
+
+	hs_result("store write cccd", start, ITERATIONS);
+
+	memset(&key, 0, sizeof(key));
+	start = hs_time_ns();
+
+	for(size_t i=0; i<ITERATIONS; i++){
+		peer_addr(&key.peer_addr, 0);
+		key.chr_val_handle = 1 + i % CCCDS;
+
+		CHECK(ble_store_read_cccd(&key, &value) == 0);
+		CHECK(value.chr_val_handle == key.chr_val_handle);
+	}
+
+	hs_result("store read cccd", start, ITERATIONS);
+
+	return 0;
+}
+
+static void peer_addr(ble_addr_t *addr, size_t peer){
+	memset(addr, 0, sizeof(*addr));
+	addr->type = BLE_ADDR_PUBLIC;
+	addr->val[0] = peer;
+	addr->val[5] = 0xc0;
+}
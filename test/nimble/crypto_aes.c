@@ -0,0 +1,151 @@
+// Host test and benchmark of the tinycrypt AES-128 cipher, used for the SM key
+// generation and AES-CMAC. The known answers are the FIPS-197 examples of
+// appendix A.1, B and C.1. The sources are included directly, cf. os.c, and
+// built with the byte oriented cipher here and with the table driven one by
+// crypto_aes_ttable.c.
+#include "nimble/ext/tinycrypt/src/aes_encrypt.c"
+#include "nimble/ext/tinycrypt/src/utils.c"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define CHAIN		1000
+#define BLOCKS		1000000
+
+
+/* types */
+typedef struct{
+	uint8_t key[TC_AES_KEY_SIZE];
+	uint8_t plain[TC_AES_BLOCK_SIZE];
+	uint8_t cipher[TC_AES_BLOCK_SIZE];
+} aes_vector_t;
+
+
+/* local/static prototypes */
+static int test_vectors(void);
+static int test_chain(void);
+static int bench(void);
+
+static uint64_t time_ns(void);
+
+
+/* static variables */
+static aes_vector_t const vectors[] = {
+	// appendix b
+	{
+		.key = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c },
+		.plain = { 0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d, 0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34 },
+		.cipher = { 0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb, 0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32 },
+	},
+	// appendix c.1
+	{
+		.key = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+		.plain = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+		.cipher = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a },
+	},
+};
+
+// repeated encryptions of the zero block, i.e. the last block of the cbc
+// encryption of as many zero blocks with a zero iv, under the appendix c.1 key
+// for CHAIN blocks and under the appendix b key for BLOCKS blocks
+static uint8_t const chain_cipher[TC_AES_BLOCK_SIZE] = {
+	0x1f, 0xd0, 0x9a, 0xe8, 0x7c, 0x72, 0x58, 0x99, 0x0c, 0xc5, 0x61, 0x56, 0x46, 0x0f, 0xf2, 0x06,
+};
+
+static uint8_t const bench_cipher[TC_AES_BLOCK_SIZE] = {
+	0x90, 0xcf, 0xe9, 0xb7, 0x98, 0x9d, 0x1a, 0xe2, 0x46, 0x5b, 0x66, 0xea, 0x62, 0xcc, 0xd0, 0xe2,
+};
+
+
+/* global functions */
+int main(int argc, char **argv){
+	printf("aes: %s\n", TC_AES_TTABLE ? "table driven" : "byte oriented");
+
+	if(test_vectors() != 0
+	|| test_chain() != 0
+	|| bench() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int test_vectors(void){
+	struct tc_aes_key_sched_struct s;
+	uint8_t out[TC_AES_BLOCK_SIZE];
+
+
+	for(size_t i=0; i<sizeof(vectors) / sizeof(vectors[0]); i++){
+		CHECK(tc_aes128_set_encrypt_key(&s, vectors[i].key) == TC_CRYPTO_SUCCESS);
+
+		// last word of the appendix a.1 key expansion
+		if(i == 0)
+			CHECK(s.words[Nb * (Nr + 1) - 1] == 0xb6630ca6);
+
+		CHECK(tc_aes_encrypt(out, vectors[i].plain, &s) == TC_CRYPTO_SUCCESS);
+		CHECK(memcmp(out, vectors[i].cipher, sizeof(out)) == 0);
+
+		// in-place encryption, as done by the cmac code
+		memcpy(out, vectors[i].plain, sizeof(out));
+
+		CHECK(tc_aes_encrypt(out, out, &s) == TC_CRYPTO_SUCCESS);
+		CHECK(memcmp(out, vectors[i].cipher, sizeof(out)) == 0);
+	}
+
+	return 0;
+}
+
+static int test_chain(void){
+	struct tc_aes_key_sched_struct s;
+	uint8_t block[TC_AES_BLOCK_SIZE] = { 0 };
+
+
+	CHECK(tc_aes128_set_encrypt_key(&s, vectors[1].key) == TC_CRYPTO_SUCCESS);
+
+	for(size_t i=0; i<CHAIN; i++)
+		CHECK(tc_aes_encrypt(block, block, &s) == TC_CRYPTO_SUCCESS);
+
+	CHECK(memcmp(block, chain_cipher, sizeof(block)) == 0);
+
+	return 0;
+}
+
+static int bench(void){
+	struct tc_aes_key_sched_struct s;
+	uint8_t block[TC_AES_BLOCK_SIZE] = { 0 };
+	uint64_t start;
+
+
+	tc_aes128_set_encrypt_key(&s, vectors[0].key);
+	start = time_ns();
+
+	for(size_t i=0; i<BLOCKS; i++)
+		tc_aes_encrypt(block, block, &s);
+
+	printf("%-32s %10.1f ns/op\n", "aes-128 block", (double)(time_ns() - start) / BLOCKS);
+
+	CHECK(memcmp(block, bench_cipher, sizeof(block)) == 0);
+
+	return 0;
+}
+
+static uint64_t time_ns(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
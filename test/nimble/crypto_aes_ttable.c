@@ -0,0 +1,4 @@
+// crypto_aes.c with the table driven cipher
+#define TC_AES_TTABLE	1
+
+#include "crypto_aes.c"
@@ -0,0 +1,227 @@
+// Host test and benchmark of the tinycrypt P-256 code used for LE secure
+// connections pairing, cf. ble_sm_alg.c. The known answers are the P-256
+// test vectors of RFC 5903, section 8.1.
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "nimble/ext/tinycrypt/include/tinycrypt/ecc.h"
+#include "nimble/ext/tinycrypt/include/tinycrypt/ecc_dh.h"
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define PRODUCTS	50000
+#define KEYS		32
+#define ITERATIONS	200
+
+
+/* local/static prototypes */
+static int test_kat(void);
+static int test_mult(void);
+static int test_keys(void);
+static int bench(void);
+
+static int rng(uint8_t *dest, unsigned int size);
+static void random_int(uECC_word_t *vli);
+static uint64_t time_ns(void);
+
+
+/* static variables */
+// private keys and public keys of the initiator (i) and responder (r) as well
+// as the shared secret
+static uint8_t const kat_i[NUM_ECC_BYTES] = {
+	0xc8, 0x8f, 0x01, 0xf5, 0x10, 0xd9, 0xac, 0x3f, 0x70, 0xa2, 0x92, 0xda, 0xa2, 0x31, 0x6d, 0xe5,
+	0x44, 0xe9, 0xaa, 0xb8, 0xaf, 0xe8, 0x40, 0x49, 0xc6, 0x2a, 0x9c, 0x57, 0x86, 0x2d, 0x14, 0x33,
+};
+
+static uint8_t const kat_gi[2 * NUM_ECC_BYTES] = {
+	0xda, 0xd0, 0xb6, 0x53, 0x94, 0x22, 0x1c, 0xf9, 0xb0, 0x51, 0xe1, 0xfe, 0xca, 0x57, 0x87, 0xd0,
+	0x98, 0xdf, 0xe6, 0x37, 0xfc, 0x90, 0xb9, 0xef, 0x94, 0x5d, 0x0c, 0x37, 0x72, 0x58, 0x11, 0x80,
+	0x52, 0x71, 0xa0, 0x46, 0x1c, 0xdb, 0x82, 0x52, 0xd6, 0x1f, 0x1c, 0x45, 0x6f, 0xa3, 0xe5, 0x9a,
+	0xb1, 0xf4, 0x5b, 0x33, 0xac, 0xcf, 0x5f, 0x58, 0x38, 0x9e, 0x05, 0x77, 0xb8, 0x99, 0x0b, 0xb3,
+};
+
+static uint8_t const kat_r[NUM_ECC_BYTES] = {
+	0xc6, 0xef, 0x9c, 0x5d, 0x78, 0xae, 0x01, 0x2a, 0x01, 0x11, 0x64, 0xac, 0xb3, 0x97, 0xce, 0x20,
+	0x88, 0x68, 0x5d, 0x8f, 0x06, 0xbf, 0x9b, 0xe0, 0xb2, 0x83, 0xab, 0x46, 0x47, 0x6b, 0xee, 0x53,
+};
+
+static uint8_t const kat_gr[2 * NUM_ECC_BYTES] = {
+	0xd1, 0x2d, 0xfb, 0x52, 0x89, 0xc8, 0xd4, 0xf8, 0x12, 0x08, 0xb7, 0x02, 0x70, 0x39, 0x8c, 0x34,
+	0x22, 0x96, 0x97, 0x0a, 0x0b, 0xcc, 0xb7, 0x4c, 0x73, 0x6f, 0xc7, 0x55, 0x44, 0x94, 0xbf, 0x63,
+	0x56, 0xfb, 0xf3, 0xca, 0x36, 0x6c, 0xc2, 0x3e, 0x81, 0x57, 0x85, 0x4c, 0x13, 0xc5, 0x8d, 0x6a,
+	0xac, 0x23, 0xf0, 0x46, 0xad, 0xa3, 0x0f, 0x83, 0x53, 0xe7, 0x4f, 0x33, 0x03, 0x98, 0x72, 0xab,
+};
+
+static uint8_t const kat_gir[NUM_ECC_BYTES] = {
+	0xd6, 0x84, 0x0f, 0x6b, 0x42, 0xf6, 0xed, 0xaf, 0xd1, 0x31, 0x16, 0xe0, 0xe1, 0x25, 0x65, 0x20,
+	0x2f, 0xef, 0x8e, 0x9e, 0xce, 0x7d, 0xce, 0x03, 0x81, 0x24, 0x64, 0xd0, 0x4b, 0x94, 0x42, 0xde,
+};
+
+static uint64_t rng_state = 0x123456789abcdef;
+
+
+/* global functions */
+int main(int argc, char **argv){
+	uECC_set_rng(rng);
+
+	if(test_kat() != 0
+	|| test_mult() != 0
+	|| test_keys() != 0
+	|| bench() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int test_kat(void){
+	uint8_t public[2 * NUM_ECC_BYTES];
+	uint8_t secret[NUM_ECC_BYTES];
+
+
+	CHECK(uECC_compute_public_key(kat_i, public, uECC_secp256r1()) == 1);
+	CHECK(memcmp(public, kat_gi, sizeof(public)) == 0);
+
+	CHECK(uECC_compute_public_key(kat_r, public, uECC_secp256r1()) == 1);
+	CHECK(memcmp(public, kat_gr, sizeof(public)) == 0);
+
+	CHECK(uECC_valid_public_key(kat_gi, uECC_secp256r1()) == 0);
+	CHECK(uECC_valid_public_key(kat_gr, uECC_secp256r1()) == 0);
+
+	CHECK(uECC_shared_secret(kat_gr, kat_i, secret, uECC_secp256r1()) == 1);
+	CHECK(memcmp(secret, kat_gir, sizeof(secret)) == 0);
+
+	CHECK(uECC_shared_secret(kat_gi, kat_r, secret, uECC_secp256r1()) == 1);
+	CHECK(memcmp(secret, kat_gir, sizeof(secret)) == 0);
+
+	// points off the curve have to be rejected
+	memcpy(public, kat_gi, sizeof(public));
+	public[sizeof(public) - 1] ^= 0x1;
+
+	CHECK(uECC_valid_public_key(public, uECC_secp256r1()) != 0);
+
+	return 0;
+}
+
+static int test_mult(void){
+	uECC_Curve curve = uECC_secp256r1();
+	uECC_word_t left[NUM_ECC_WORDS],
+				right[NUM_ECC_WORDS];
+	uECC_word_t fast[NUM_ECC_WORDS],
+				ref[NUM_ECC_WORDS];
+
+
+	// the p-256 specific reduction against the generic one, including the
+	// extreme values 0 and p - 1
+	for(size_t i=0; i<PRODUCTS; i++){
+		random_int(left);
+		random_int(right);
+
+		if(i % 1000 == 0){
+			memset(left, 0, sizeof(left));
+			uECC_vli_set(right, curve->p, NUM_ECC_WORDS);
+			right[0]--;
+		}
+		else if(i % 1000 == 1){
+			uECC_vli_set(left, curve->p, NUM_ECC_WORDS);
+			left[0]--;
+			uECC_vli_set(right, left, NUM_ECC_WORDS);
+		}
+
+		uECC_vli_modMult_fast(fast, left, right, curve);
+		uECC_vli_modMult(ref, left, right, curve->p, NUM_ECC_WORDS);
+
+		CHECK(uECC_vli_equal(fast, ref, NUM_ECC_WORDS) == 0);
+	}
+
+	return 0;
+}
+
+static int test_keys(void){
+	uint8_t public_a[2 * NUM_ECC_BYTES],
+			public_b[2 * NUM_ECC_BYTES];
+	uint8_t private_a[NUM_ECC_BYTES],
+			private_b[NUM_ECC_BYTES];
+	uint8_t secret_a[NUM_ECC_BYTES],
+			secret_b[NUM_ECC_BYTES];
+
+
+	for(size_t i=0; i<KEYS; i++){
+		CHECK(uECC_make_key(public_a, private_a, uECC_secp256r1()) == 1);
+		CHECK(uECC_make_key(public_b, private_b, uECC_secp256r1()) == 1);
+
+		CHECK(uECC_valid_public_key(public_a, uECC_secp256r1()) == 0);
+		CHECK(uECC_valid_public_key(public_b, uECC_secp256r1()) == 0);
+
+		CHECK(uECC_shared_secret(public_b, private_a, secret_a, uECC_secp256r1()) == 1);
+		CHECK(uECC_shared_secret(public_a, private_b, secret_b, uECC_secp256r1()) == 1);
+		CHECK(memcmp(secret_a, secret_b, sizeof(secret_a)) == 0);
+	}
+
+	return 0;
+}
+
+static int bench(void){
+	uint8_t public[2 * NUM_ECC_BYTES];
+	uint8_t private[NUM_ECC_BYTES];
+	uint8_t secret[NUM_ECC_BYTES];
+	uint64_t start;
+
+
+	// one key pair and one shared secret per pairing, cf. ble_sm_alg.c
+	start = time_ns();
+
+	for(size_t i=0; i<ITERATIONS; i++)
+		CHECK(uECC_make_key(public, private, uECC_secp256r1()) == 1);
+
+	printf("%-32s %10.1f us/op\n", "p256 make key", (double)(time_ns() - start) / ITERATIONS / 1000);
+
+	start = time_ns();
+
+	for(size_t i=0; i<ITERATIONS; i++)
+		CHECK(uECC_shared_secret(kat_gr, kat_i, secret, uECC_secp256r1()) == 1);
+
+	printf("%-32s %10.1f us/op\n", "p256 shared secret", (double)(time_ns() - start) / ITERATIONS / 1000);
+
+	CHECK(memcmp(secret, kat_gir, sizeof(secret)) == 0);
+
+	return 0;
+}
+
+static int rng(uint8_t *dest, unsigned int size){
+	// xorshift64, reproducible key pairs
+	for(unsigned int i=0; i<size; i++){
+		rng_state ^= rng_state << 13;
+		rng_state ^= rng_state >> 7;
+		rng_state ^= rng_state << 17;
+		dest[i] = rng_state;
+	}
+
+	return 1;
+}
+
+static void random_int(uECC_word_t *vli){
+	rng((uint8_t*)vli, NUM_ECC_BYTES);
+
+	// keep the value below p, whose most significant word is 0xffffffff
+	if(vli[NUM_ECC_WORDS - 1] == 0xffffffff)
+		vli[NUM_ECC_WORDS - 1]--;
+}
+
+static uint64_t time_ns(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
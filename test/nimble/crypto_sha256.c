@@ -0,0 +1,270 @@
+// Host test and benchmark of the tinycrypt SHA-256 and HMAC-SHA256 code. The
+// known answers are the FIPS 180-2 SHA-256 examples and the HMAC-SHA256 test
+// cases of RFC 4231. The sources are included directly, cf. os.c.
+
+// tc_hmac_set_key() hashes an uninitialised dummy key on purpose, to keep short
+// and long keys from differing in time
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "nimble/ext/tinycrypt/src/sha256.c"
+#include "nimble/ext/tinycrypt/src/hmac.c"
+#include "nimble/ext/tinycrypt/src/utils.c"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define MILLION_A		1000000
+#define BENCH_SIZE		(1024 * 1024)
+#define BENCH_ROUNDS	64
+#define MACS			200000
+
+
+/* types */
+typedef struct{
+	char const *data;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+} sha256_vector_t;
+
+typedef struct{
+	uint8_t key[131];
+	size_t key_len;
+	uint8_t data[152];
+	size_t data_len;
+	uint8_t mac[TC_SHA256_DIGEST_SIZE];
+} hmac_vector_t;
+
+
+/* local/static prototypes */
+static int test_sha256(void);
+static int test_sha256_chunks(void);
+static int test_hmac(void);
+static int bench(void);
+
+static uint64_t time_ns(void);
+
+
+/* static variables */
+static sha256_vector_t const sha256_vectors[] = {
+	{
+		.data = "",
+		.digest = {
+			0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+			0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55,
+		},
+	},
+	{
+		.data = "abc",
+		.digest = {
+			0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+			0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad,
+		},
+	},
+	{
+		.data = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+		.digest = {
+			0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+			0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1,
+		},
+	},
+};
+
+static uint8_t const million_a_digest[TC_SHA256_DIGEST_SIZE] = {
+	0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+	0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0,
+};
+
+// rfc 4231 test cases 1 to 4, 6 and 7, test case 5 covers truncated macs only
+static hmac_vector_t const hmac_vectors[] = {
+	{
+		.key = { [0 ... 19] = 0x0b },
+		.key_len = 20,
+		.data = "Hi There",
+		.data_len = 8,
+		.mac = {
+			0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, 0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b,
+			0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7,
+		},
+	},
+	{
+		.key = "Jefe",
+		.key_len = 4,
+		.data = "what do ya want for nothing?",
+		.data_len = 28,
+		.mac = {
+			0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+			0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43,
+		},
+	},
+	{
+		.key = { [0 ... 19] = 0xaa },
+		.key_len = 20,
+		.data = { [0 ... 49] = 0xdd },
+		.data_len = 50,
+		.mac = {
+			0x77, 0x3e, 0xa9, 0x1e, 0x36, 0x80, 0x0e, 0x46, 0x85, 0x4d, 0xb8, 0xeb, 0xd0, 0x91, 0x81, 0xa7,
+			0x29, 0x59, 0x09, 0x8b, 0x3e, 0xf8, 0xc1, 0x22, 0xd9, 0x63, 0x55, 0x14, 0xce, 0xd5, 0x65, 0xfe,
+		},
+	},
+	{
+		.key = {
+			0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+			0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+		},
+		.key_len = 25,
+		.data = { [0 ... 49] = 0xcd },
+		.data_len = 50,
+		.mac = {
+			0x82, 0x55, 0x8a, 0x38, 0x9a, 0x44, 0x3c, 0x0e, 0xa4, 0xcc, 0x81, 0x98, 0x99, 0xf2, 0x08, 0x3a,
+			0x85, 0xf0, 0xfa, 0xa3, 0xe5, 0x78, 0xf8, 0x07, 0x7a, 0x2e, 0x3f, 0xf4, 0x67, 0x29, 0x66, 0x5b,
+		},
+	},
+	{
+		.key = { [0 ... 130] = 0xaa },
+		.key_len = 131,
+		.data = "Test Using Larger Than Block-Size Key - Hash Key First",
+		.data_len = 54,
+		.mac = {
+			0x60, 0xe4, 0x31, 0x59, 0x1e, 0xe0, 0xb6, 0x7f, 0x0d, 0x8a, 0x26, 0xaa, 0xcb, 0xf5, 0xb7, 0x7f,
+			0x8e, 0x0b, 0xc6, 0x21, 0x37, 0x28, 0xc5, 0x14, 0x05, 0x46, 0x04, 0x0f, 0x0e, 0xe3, 0x7f, 0x54,
+		},
+	},
+	{
+		.key = { [0 ... 130] = 0xaa },
+		.key_len = 131,
+		.data = "This is a test using a larger than block-size key and a larger than block-size data. The key needs to be hashed before being used by the HMAC algorithm.",
+		.data_len = 152,
+		.mac = {
+			0x9b, 0x09, 0xff, 0xa7, 0x1b, 0x94, 0x2f, 0xcb, 0x27, 0x63, 0x5f, 0xbc, 0xd5, 0xb0, 0xe9, 0x44,
+			0xbf, 0xdc, 0x63, 0x64, 0x4f, 0x07, 0x13, 0x93, 0x8a, 0x7f, 0x51, 0x53, 0x5c, 0x3a, 0x35, 0xe2,
+		},
+	},
+};
+
+static uint8_t bench_buf[BENCH_SIZE];
+
+
+/* global functions */
+int main(int argc, char **argv){
+	if(test_sha256() != 0
+	|| test_sha256_chunks() != 0
+	|| test_hmac() != 0
+	|| bench() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int test_sha256(void){
+	struct tc_sha256_state_struct s;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+
+
+	for(size_t i=0; i<sizeof(sha256_vectors) / sizeof(sha256_vectors[0]); i++){
+		CHECK(tc_sha256_init(&s) == TC_CRYPTO_SUCCESS);
+		CHECK(tc_sha256_update(&s, (uint8_t const*)sha256_vectors[i].data, strlen(sha256_vectors[i].data)) == TC_CRYPTO_SUCCESS);
+		CHECK(tc_sha256_final(digest, &s) == TC_CRYPTO_SUCCESS);
+		CHECK(memcmp(digest, sha256_vectors[i].digest, sizeof(digest)) == 0);
+	}
+
+	return 0;
+}
+
+static int test_sha256_chunks(void){
+	// chunk sizes around the block size to hit partial, whole and mixed blocks
+	static size_t const chunks[] = { 1, 63, 64, 65, 127, 128, 200, 3 };
+	struct tc_sha256_state_struct s;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	size_t len;
+
+
+	memset(bench_buf, 'a', MILLION_A);
+
+	CHECK(tc_sha256_init(&s) == TC_CRYPTO_SUCCESS);
+
+	for(size_t i=0, n=0; n<MILLION_A; i++, n+=len){
+		len = chunks[i % (sizeof(chunks) / sizeof(chunks[0]))];
+
+		if(len > MILLION_A - n)
+			len = MILLION_A - n;
+
+		CHECK(tc_sha256_update(&s, bench_buf + n, len) == TC_CRYPTO_SUCCESS);
+	}
+
+	CHECK(tc_sha256_final(digest, &s) == TC_CRYPTO_SUCCESS);
+	CHECK(memcmp(digest, million_a_digest, sizeof(digest)) == 0);
+
+	return 0;
+}
+
+static int test_hmac(void){
+	struct tc_hmac_state_struct h;
+	uint8_t mac[TC_SHA256_DIGEST_SIZE];
+	hmac_vector_t const *v;
+
+
+	for(size_t i=0; i<sizeof(hmac_vectors) / sizeof(hmac_vectors[0]); i++){
+		v = hmac_vectors + i;
+
+		CHECK(tc_hmac_set_key(&h, v->key, v->key_len) == TC_CRYPTO_SUCCESS);
+		CHECK(tc_hmac_init(&h) == TC_CRYPTO_SUCCESS);
+		CHECK(tc_hmac_update(&h, v->data, v->data_len) == TC_CRYPTO_SUCCESS);
+		CHECK(tc_hmac_final(mac, sizeof(mac), &h) == TC_CRYPTO_SUCCESS);
+		CHECK(memcmp(mac, v->mac, sizeof(mac)) == 0);
+	}
+
+	return 0;
+}
+
+static int bench(void){
+	struct tc_sha256_state_struct s;
+	struct tc_hmac_state_struct h;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	uint64_t start;
+
+
+	start = time_ns();
+
+	for(size_t i=0; i<BENCH_ROUNDS; i++){
+		tc_sha256_init(&s);
+		tc_sha256_update(&s, bench_buf, sizeof(bench_buf));
+		tc_sha256_final(digest, &s);
+	}
+
+	printf("%-32s %10.1f MB/s\n", "sha256", (double)BENCH_ROUNDS * BENCH_SIZE * 1000 / (time_ns() - start));
+
+	// short messages are dominated by the padding and the inner and outer hash
+	tc_hmac_set_key(&h, hmac_vectors[0].key, hmac_vectors[0].key_len);
+	start = time_ns();
+
+	for(size_t i=0; i<MACS; i++){
+		tc_hmac_init(&h);
+		tc_hmac_update(&h, bench_buf, 64);
+		tc_hmac_final(digest, sizeof(digest), &h);
+	}
+
+	printf("%-32s %10.1f ns/op\n", "hmac-sha256, 64 bytes", (double)(time_ns() - start) / MACS);
+
+	return 0;
+}
+
+static uint64_t time_ns(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
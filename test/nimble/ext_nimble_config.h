@@ -0,0 +1,18 @@
+#ifndef NIMBLE_TEST_EXT_CONFIG_H
+#define NIMBLE_TEST_EXT_CONFIG_H
+
+
+// Host builds are not ESP_PLATFORM builds, hence syscfg.h includes this header
+// instead of esp_nimble_cfg.h. Use the same configuration as the firmware,
+// except for the parts that need ESP-IDF services.
+
+// the bond store is kept in RAM instead of NVS
+#define MYNEWT_VAL_BLE_STORE_CONFIG_PERSIST	(0)
+
+// the connection event hook runs on esp_timer
+#define MYNEWT_VAL_BLE_GAP_CONN_EVENT_HOOK	(0)
+
+#include "nimble/esp_port/port/include/esp_nimble_cfg.h"
+
+
+#endif // NIMBLE_TEST_EXT_CONFIG_H
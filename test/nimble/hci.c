@@ -0,0 +1,320 @@
+#include <assert.h>
+#include <string.h>
+#include "npl.h"
+#include "hci.h"
+#include "nimble/nimble/include/nimble/ble.h"
+#include "nimble/nimble/include/nimble/ble_hci_trans.h"
+#include "nimble/nimble/include/nimble/hci_common.h"
+#include "nimble/porting/nimble/include/os/os_mbuf.h"
+#include "nimble/porting/nimble/include/os/os_mempool.h"
+#include "nimble/porting/nimble/include/os/endian.h"
+
+
+/* macros */
+#define EVT_HI_BLOCKS	MYNEWT_VAL(BLE_HCI_EVT_HI_BUF_COUNT)
+#define EVT_LO_BLOCKS	MYNEWT_VAL(BLE_HCI_EVT_LO_BUF_COUNT)
+#define EVT_BLOCK_SIZE	MYNEWT_VAL(BLE_HCI_EVT_BUF_SIZE)
+
+// cf. esp_nimble_hci.c
+#define ACL_BLOCKS		MYNEWT_VAL(BLE_ACL_BUF_COUNT)
+#define ACL_BLOCK_SIZE	OS_ALIGN(MYNEWT_VAL(BLE_ACL_BUF_SIZE) + BLE_MBUF_MEMBLOCK_OVERHEAD + BLE_HCI_DATA_HDR_SZ, OS_ALIGNMENT)
+
+#define L2CAP_HDR_SIZE	4
+
+
+/* local/static prototypes */
+static int evt_tx(uint8_t code, void const *data, uint8_t len);
+static int conn_complete(void);
+
+
+/* global variables */
+hci_stats_t hci_stats = { 0 };
+
+
+/* static variables */
+static ble_hci_trans_rx_cmd_fn *evt_cb = 0x0;
+static void *evt_arg = 0x0;
+static ble_hci_trans_rx_acl_fn *acl_cb = 0x0;
+static void *acl_arg = 0x0;
+
+static os_membuf_t cmd_buf[OS_MEMPOOL_SIZE(1, BLE_HCI_TRANS_CMD_SZ)];
+static struct os_mempool cmd_pool;
+
+static os_membuf_t evt_hi_buf[OS_MEMPOOL_SIZE(EVT_HI_BLOCKS, EVT_BLOCK_SIZE)];
+static struct os_mempool evt_hi_pool;
+
+static os_membuf_t evt_lo_buf[OS_MEMPOOL_SIZE(EVT_LO_BLOCKS, EVT_BLOCK_SIZE)];
+static struct os_mempool evt_lo_pool;
+
+static os_membuf_t acl_buf[OS_MEMPOOL_SIZE(ACL_BLOCKS, ACL_BLOCK_SIZE)];
+static struct os_mempool_ext acl_pool;
+static struct os_mbuf_pool acl_mbuf_pool;
+
+static uint8_t const central_addr[6] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc0 };
+
+
+/* global functions */
+void hci_init(void){
+	memset(&hci_stats, 0, sizeof(hci_stats));
+
+	os_mempool_init(&cmd_pool, 1, BLE_HCI_TRANS_CMD_SZ, cmd_buf, "hci_cmd");
+	os_mempool_init(&evt_hi_pool, EVT_HI_BLOCKS, EVT_BLOCK_SIZE, evt_hi_buf, "hci_evt_hi");
+	os_mempool_init(&evt_lo_pool, EVT_LO_BLOCKS, EVT_BLOCK_SIZE, evt_lo_buf, "hci_evt_lo");
+	os_mempool_ext_init(&acl_pool, ACL_BLOCKS, ACL_BLOCK_SIZE, acl_buf, "hci_acl");
+	os_mbuf_pool_init(&acl_mbuf_pool, &acl_pool.mpe_mp, ACL_BLOCK_SIZE, ACL_BLOCKS);
+}
+
+void hci_conn_event(void){
+	uint8_t data[sizeof(struct ble_hci_ev_num_comp_pkts) + sizeof(struct comp_pkt)];
+	struct ble_hci_ev_num_comp_pkts *ev = (void*)data;
+
+
+	if(hci_stats.acl_pending == 0)
+		return;
+
+	ev->count = 1;
+	ev->completed[0].handle = htole16(HCI_CONN_HANDLE);
+	ev->completed[0].packets = htole16(hci_stats.acl_pending);
+
+	if(evt_tx(BLE_HCI_EVCODE_NUM_COMP_PKTS, data, sizeof(data)) == 0)
+		hci_stats.acl_pending = 0;
+}
+
+int hci_l2cap_rx(uint16_t cid, void const *pdu, uint16_t len){
+	uint8_t hdr[BLE_HCI_DATA_HDR_SZ + L2CAP_HDR_SIZE];
+	uint16_t usrhdr_len = 0;
+	struct os_mbuf *om;
+
+
+	if(acl_cb == 0x0 || len + L2CAP_HDR_SIZE > MYNEWT_VAL(BLE_ACL_BUF_SIZE))
+		return -1;
+
+#if MYNEWT_VAL(BLE_HS_FLOW_CTRL)
+	usrhdr_len = BLE_MBUF_HS_HDR_LEN;
+#endif // MYNEWT_VAL(BLE_HS_FLOW_CTRL)
+
+	om = os_mbuf_get_pkthdr(&acl_mbuf_pool, usrhdr_len);
+
+	if(om == 0x0)
+		return -1;
+
+	put_le16(hdr, HCI_CONN_HANDLE | (BLE_HCI_PB_FIRST_FLUSH << 12));
+	put_le16(hdr + 2, len + L2CAP_HDR_SIZE);
+	put_le16(hdr + 4, len);
+	put_le16(hdr + 6, cid);
+
+	if(os_mbuf_append(om, hdr, sizeof(hdr)) != 0 || os_mbuf_append(om, pdu, len) != 0){
+		os_mbuf_free_chain(om);
+		return -1;
+	}
+
+	return acl_cb(om, acl_arg);
+}
+
+void ble_hci_trans_cfg_hs(ble_hci_trans_rx_cmd_fn *cmd_cb, void *cmd_arg, ble_hci_trans_rx_acl_fn *rx_acl_cb, void *rx_acl_arg){
+	evt_cb = cmd_cb;
+	evt_arg = cmd_arg;
+	acl_cb = rx_acl_cb;
+	acl_arg = rx_acl_arg;
+}
+
+int ble_hci_trans_hs_cmd_tx(uint8_t *cmd){
+	struct ble_hci_cmd *hdr = (void*)cmd;
+	uint16_t opcode = le16toh(hdr->opcode);
+	bool connect = false;
+	union{
+		struct ble_hci_ip_rd_local_ver_rp local_ver;
+		struct ble_hci_ip_rd_loc_supp_feat_rp feat;
+		struct ble_hci_ip_rd_bd_addr_rp bd_addr;
+		struct ble_hci_le_rd_buf_size_rp buf_size;
+		struct ble_hci_le_rd_loc_supp_feat_rp le_feat;
+		struct ble_hci_le_rd_adv_chan_txpwr_rp txpwr;
+		struct ble_hci_le_rand_rp rand;
+		struct ble_hci_le_set_data_len_rp data_len;
+	} rp;
+	uint8_t rp_len = 0;
+	uint8_t data[sizeof(struct ble_hci_ev_command_complete) + sizeof(rp)];
+	struct ble_hci_ev_command_complete *ev = (void*)data;
+
+
+	hci_stats.cmds++;
+	memset(&rp, 0, sizeof(rp));
+
+	// commands the host expects return parameters for
+	switch(opcode){
+	case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_LOCAL_VER):
+		rp.local_ver.hci_ver = BLE_HCI_VER_BCS_5_2;
+		rp.local_ver.lmp_ver = BLE_LMP_VER_BCS_5_2;
+		rp_len = sizeof(rp.local_ver);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_LOC_SUPP_FEAT):
+		rp.feat.features = htole64(0x0000006000000000);	// LE supported
+		rp_len = sizeof(rp.feat);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_INFO_PARAMS, BLE_HCI_OCF_IP_RD_BD_ADDR):
+		memcpy(rp.bd_addr.addr, central_addr, 6);
+		rp.bd_addr.addr[0]++;
+		rp_len = sizeof(rp.bd_addr);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_BUF_SIZE):
+		rp.buf_size.data_len = htole16(HCI_ACL_DATA_LEN);
+		rp.buf_size.data_packets = HCI_ACL_PACKETS;
+		rp_len = sizeof(rp.buf_size);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_LOC_SUPP_FEAT):
+		rp_len = sizeof(rp.le_feat);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RD_ADV_CHAN_TXPWR):
+		rp_len = sizeof(rp.txpwr);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_RAND):
+		rp.rand.random_number = 0x0123456789abcdef;
+		rp_len = sizeof(rp.rand);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_SET_DATA_LEN):
+		rp.data_len.conn_handle = htole16(HCI_CONN_HANDLE);
+		rp_len = sizeof(rp.data_len);
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_CTLR_BASEBAND, BLE_HCI_OCF_CB_RESET):
+		hci_stats.acl_pending = 0;
+		break;
+
+	case BLE_HCI_OP(BLE_HCI_OGF_LE, BLE_HCI_OCF_LE_SET_ADV_ENABLE):
+		connect = ((struct ble_hci_le_set_adv_enable_cp*)hdr->data)->enable;
+		break;
+	}
+
+	ble_hci_trans_buf_free(cmd);
+
+	ev->num_packets = 1;
+	ev->opcode = htole16(opcode);
+	ev->status = BLE_ERR_SUCCESS;
+	memcpy(ev->return_params, &rp, rp_len);
+
+	if(evt_tx(BLE_HCI_EVCODE_COMMAND_COMPLETE, data, sizeof(*ev) + rp_len) != 0)
+		return BLE_ERR_MEM_CAPACITY;
+
+	// the central connects as soon as the device advertises
+	if(connect)
+		return conn_complete();
+
+	return 0;
+}
+
+int ble_hci_trans_hs_acl_tx(struct os_mbuf *om){
+	uint8_t data[BLE_HCI_DATA_HDR_SZ + HCI_ACL_DATA_LEN];
+	uint16_t len = OS_MBUF_PKTLEN(om);
+
+
+	// the host has to stick to the buffers reported by LE Read Buffer Size
+	assert(len <= sizeof(data));
+	assert(hci_stats.acl_pending < HCI_ACL_PACKETS);
+
+	os_mbuf_copydata(om, 0, len, data);
+	os_mbuf_free_chain(om);
+
+	hci_stats.acl_pkts++;
+	hci_stats.acl_bytes += len - BLE_HCI_DATA_HDR_SZ;
+	hci_stats.acl_pending++;
+
+	if(len >= BLE_HCI_DATA_HDR_SZ + L2CAP_HDR_SIZE){
+		hci_stats.len = get_le16(data + BLE_HCI_DATA_HDR_SZ);
+		hci_stats.cid = get_le16(data + BLE_HCI_DATA_HDR_SZ + 2);
+
+		if(hci_stats.len > len - BLE_HCI_DATA_HDR_SZ - L2CAP_HDR_SIZE)
+			hci_stats.len = len - BLE_HCI_DATA_HDR_SZ - L2CAP_HDR_SIZE;
+
+		memcpy(hci_stats.pdu, data + BLE_HCI_DATA_HDR_SZ + L2CAP_HDR_SIZE, hci_stats.len);
+	}
+
+	return 0;
+}
+
+uint8_t *ble_hci_trans_buf_alloc(int type){
+	uint8_t *buf;
+
+
+	switch(type){
+	case BLE_HCI_TRANS_BUF_CMD:
+		return os_memblock_get(&cmd_pool);
+
+	case BLE_HCI_TRANS_BUF_EVT_HI:
+		buf = os_memblock_get(&evt_hi_pool);
+
+		if(buf != 0x0)
+			return buf;
+
+		// fall through
+	case BLE_HCI_TRANS_BUF_EVT_LO:
+		return os_memblock_get(&evt_lo_pool);
+	}
+
+	return 0x0;
+}
+
+void ble_hci_trans_buf_free(uint8_t *buf){
+	if(os_memblock_from(&evt_hi_pool, buf))
+		os_memblock_put(&evt_hi_pool, buf);
+	else if(os_memblock_from(&evt_lo_pool, buf))
+		os_memblock_put(&evt_lo_pool, buf);
+	else
+		os_memblock_put(&cmd_pool, buf);
+}
+
+int ble_hci_trans_set_acl_free_cb(os_mempool_put_fn *cb, void *arg){
+	acl_pool.mpe_put_cb = cb;
+	acl_pool.mpe_put_arg = arg;
+
+	return 0;
+}
+
+int ble_hci_trans_reset(void){
+	return 0;
+}
+
+
+/* local functions */
+static int evt_tx(uint8_t code, void const *data, uint8_t len){
+	struct ble_hci_ev *ev;
+
+
+	if(evt_cb == 0x0)
+		return -1;
+
+	ev = (void*)ble_hci_trans_buf_alloc(BLE_HCI_TRANS_BUF_EVT_HI);
+
+	if(ev == 0x0)
+		return -1;
+
+	ev->opcode = code;
+	ev->length = len;
+	memcpy(ev->data, data, len);
+
+	return evt_cb((uint8_t*)ev, evt_arg);
+}
+
+static int conn_complete(void){
+	struct ble_hci_ev_le_subev_conn_complete ev;
+
+
+	memset(&ev, 0, sizeof(ev));
+
+	ev.subev_code = BLE_HCI_LE_SUBEV_CONN_COMPLETE;
+	ev.status = BLE_ERR_SUCCESS;
+	ev.conn_handle = htole16(HCI_CONN_HANDLE);
+	ev.role = BLE_HCI_LE_CONN_COMPLETE_ROLE_SLAVE;
+	ev.peer_addr_type = BLE_ADDR_PUBLIC;
+	memcpy(ev.peer_addr, central_addr, 6);
+	ev.conn_itvl = htole16(6);				// 7.5 ms
+	ev.supervision_timeout = htole16(200);	// 2 s
+
+	return evt_tx(BLE_HCI_EVCODE_LE_META, &ev, sizeof(ev));
+}
@@ -0,0 +1,44 @@
+#ifndef NIMBLE_TEST_HCI_H
+#define NIMBLE_TEST_HCI_H
+
+
+// Loopback HCI transport taking the place of the controller. Commands are
+// answered right away by a Command Complete event, enabling advertising
+// connects a fake central and ACL data sent by the host is recorded and only
+// reported as completed by hci_conn_event(), i.e. once per connection event.
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* macros */
+#define HCI_CONN_HANDLE		0x1
+#define HCI_ACL_DATA_LEN	251
+#define HCI_ACL_PACKETS		12
+
+
+/* types */
+typedef struct{
+	size_t cmds;			// commands received from the host
+	size_t acl_pkts,		// ACL packets and payload received from the host
+		   acl_bytes;
+	size_t acl_pending;		// ACL packets not yet reported as completed
+
+	// L2CAP PDU of the most recent ACL packet
+	uint16_t cid;
+	uint16_t len;
+	uint8_t pdu[HCI_ACL_DATA_LEN];
+} hci_stats_t;
+
+
+/* global variables */
+extern hci_stats_t hci_stats;
+
+
+/* prototypes */
+void hci_init(void);
+
+void hci_conn_event(void);
+int hci_l2cap_rx(uint16_t cid, void const *pdu, uint16_t len);
+
+
+#endif // NIMBLE_TEST_HCI_H
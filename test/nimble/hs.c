@@ -0,0 +1,278 @@
+#include <string.h>
+#include <time.h>
+#include "npl.h"
+#include "hs.h"
+#include "hci.h"
+#include "nimble/nimble/host/include/host/ble_hs.h"
+#include "nimble/nimble/host/include/host/ble_gap.h"
+#include "nimble/nimble/host/include/host/ble_gatt.h"
+#include "nimble/nimble/host/services/gap/include/services/gap/ble_svc_gap.h"
+#include "nimble/nimble/host/services/gatt/include/services/gatt/ble_svc_gatt.h"
+#include "nimble/nimble/host/store/config/include/store/config/ble_store_config.h"
+#include "nimble/porting/nimble/include/nimble/nimble_port.h"
+#include "nimble/porting/nimble/include/os/os_mbuf.h"
+#include "nimble/porting/nimble/include/os/endian.h"
+
+
+/* macros */
+#define ATT_OP_WRITE_REQ	0x12
+#define ATT_OP_WRITE_RSP	0x13
+
+#define CCCD_NOTIFY			0x1
+
+// host events processed while waiting for a state change
+#define RUN_ATTEMPTS		100
+
+
+/* local/static prototypes */
+static int access(uint16_t conn, uint16_t attr, struct ble_gatt_access_ctxt *ctxt, void *arg);
+static int gap_event(struct ble_gap_event *event, void *arg);
+static void sync(void);
+
+// not declared by any header, cf. nimble_port.c and NimBLEDevice.h
+extern void os_msys_init(void);
+extern void ble_store_config_init(void);
+
+
+/* global variables */
+hs_t hs = { 0 };
+
+
+/* static variables */
+static bool synced = false;
+
+static uint8_t const report_map[] = {
+	0x05, 0x01, 0x09, 0x06, 0xa1, 0x01, 0x85, 0x01, 0x05, 0x07, 0x19, 0xe0, 0x29, 0xe7, 0x15, 0x00,
+	0x25, 0x01, 0x75, 0x01, 0x95, 0x08, 0x81, 0x02, 0x95, 0x01, 0x75, 0x08, 0x81, 0x01, 0x95, 0x06,
+	0x75, 0x08, 0x15, 0x00, 0x25, 0x65, 0x05, 0x07, 0x19, 0x00, 0x29, 0x65, 0x81, 0x00, 0xc0, 0x05,
+	0x0c, 0x09, 0x01, 0xa1, 0x01, 0x85, 0x02, 0x15, 0x00, 0x25, 0x01, 0x75, 0x01, 0x95, 0x10, 0xc0,
+};
+
+static uint8_t report[8] = { 0 };
+static uint8_t battery_level = 100;
+
+static struct ble_gatt_svc_def const svcs[] = {
+	{
+		.type = BLE_GATT_SVC_TYPE_PRIMARY,
+		.uuid = BLE_UUID16_DECLARE(0x180a),	// device information
+		.characteristics = (struct ble_gatt_chr_def[]){
+			{ .uuid = BLE_UUID16_DECLARE(0x2a29), .access_cb = access, .flags = BLE_GATT_CHR_F_READ, },	// manufacturer
+			{ .uuid = BLE_UUID16_DECLARE(0x2a50), .access_cb = access, .flags = BLE_GATT_CHR_F_READ, },	// pnp id
+			{ 0 },
+		},
+	},
+	{
+		.type = BLE_GATT_SVC_TYPE_PRIMARY,
+		.uuid = BLE_UUID16_DECLARE(0x1812),	// human interface device
+		.characteristics = (struct ble_gatt_chr_def[]){
+			{ .uuid = BLE_UUID16_DECLARE(0x2a4a), .access_cb = access, .flags = BLE_GATT_CHR_F_READ, },	// hid information
+			{ .uuid = BLE_UUID16_DECLARE(0x2a4b), .access_cb = access, .flags = BLE_GATT_CHR_F_READ, .val_handle = &hs.report_map, },
+			{ .uuid = BLE_UUID16_DECLARE(0x2a4c), .access_cb = access, .flags = BLE_GATT_CHR_F_WRITE_NO_RSP, },	// control point
+			{ .uuid = BLE_UUID16_DECLARE(0x2a4e), .access_cb = access, .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_WRITE_NO_RSP, },	// protocol mode
+			{
+				.uuid = BLE_UUID16_DECLARE(0x2a4d),
+				.access_cb = access,
+				.flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
+				.val_handle = &hs.report[0],
+				.descriptors = (struct ble_gatt_dsc_def[]){
+					{ .uuid = BLE_UUID16_DECLARE(0x2908), .att_flags = BLE_ATT_F_READ, .access_cb = access, },
+					{ 0 },
+				},
+			},
+			{
+				.uuid = BLE_UUID16_DECLARE(0x2a4d),
+				.access_cb = access,
+				.flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
+				.val_handle = &hs.report[1],
+				.descriptors = (struct ble_gatt_dsc_def[]){
+					{ .uuid = BLE_UUID16_DECLARE(0x2908), .att_flags = BLE_ATT_F_READ, .access_cb = access, },
+					{ 0 },
+				},
+			},
+			{
+				.uuid = BLE_UUID16_DECLARE(0x2a4d),
+				.access_cb = access,
+				.flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY,
+				.val_handle = &hs.report[2],
+				.descriptors = (struct ble_gatt_dsc_def[]){
+					{ .uuid = BLE_UUID16_DECLARE(0x2908), .att_flags = BLE_ATT_F_READ, .access_cb = access, },
+					{ 0 },
+				},
+			},
+			{
+				.uuid = BLE_UUID16_DECLARE(0x2a4d),	// keyboard output report
+				.access_cb = access,
+				.flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_WRITE | BLE_GATT_CHR_F_WRITE_NO_RSP,
+				.descriptors = (struct ble_gatt_dsc_def[]){
+					{ .uuid = BLE_UUID16_DECLARE(0x2908), .att_flags = BLE_ATT_F_READ, .access_cb = access, },
+					{ 0 },
+				},
+			},
+			{ 0 },
+		},
+	},
+	{
+		.type = BLE_GATT_SVC_TYPE_PRIMARY,
+		.uuid = BLE_UUID16_DECLARE(0x180f),	// battery
+		.characteristics = (struct ble_gatt_chr_def[]){
+			{ .uuid = BLE_UUID16_DECLARE(0x2a19), .access_cb = access, .flags = BLE_GATT_CHR_F_READ | BLE_GATT_CHR_F_NOTIFY, .val_handle = &hs.battery, },
+			{ 0 },
+		},
+	},
+	{ 0 },
+};
+
+
+/* global functions */
+int hs_init(void){
+	memset(&hs, 0, sizeof(hs));
+	hs.conn = BLE_HS_CONN_HANDLE_NONE;
+	synced = false;
+
+	// cf. nimble_port_init() and NimBLEDevice::init()
+	hci_init();
+	ble_npl_eventq_init(nimble_port_get_dflt_eventq());
+	os_msys_init();
+	ble_hs_init();
+
+	ble_hs_cfg.sync_cb = sync;
+	ble_hs_cfg.sm_io_cap = BLE_HS_IO_NO_INPUT_OUTPUT;
+	ble_hs_cfg.sm_sc = 1;
+	ble_hs_cfg.store_status_cb = ble_store_util_status_rr;
+
+	ble_svc_gap_init();
+	ble_svc_gatt_init();
+
+	if(ble_gatts_count_cfg(svcs) != 0 || ble_gatts_add_svcs(svcs) != 0)
+		return -1;
+
+	ble_store_config_init();
+
+	for(size_t i=0; i<RUN_ATTEMPTS && !synced; i++)
+		hs_run();
+
+	return synced ? 0 : -1;
+}
+
+int hs_connect(void){
+	struct ble_gap_adv_params params = {
+		.conn_mode = BLE_GAP_CONN_MODE_UND,
+		.disc_mode = BLE_GAP_DISC_MODE_GEN,
+	};
+
+
+	// the loopback central connects as soon as advertising is enabled
+	if(ble_gap_adv_start(BLE_OWN_ADDR_PUBLIC, 0x0, BLE_HS_FOREVER, &params, gap_event, 0x0) != 0)
+		return -1;
+
+	hs_run();
+
+	return hs.conn == HCI_CONN_HANDLE ? 0 : -1;
+}
+
+int hs_subscribe(uint16_t val_handle){
+	uint8_t req[5];
+	size_t subscribed = hs.subscribed;
+
+
+	// the client characteristic configuration descriptor directly follows the
+	// characteristic value
+	req[0] = ATT_OP_WRITE_REQ;
+	put_le16(req + 1, val_handle + 1);
+	put_le16(req + 3, CCCD_NOTIFY);
+
+	if(hs_att_req(req, sizeof(req), ATT_OP_WRITE_RSP) != 0)
+		return -1;
+
+	return hs.subscribed > subscribed ? 0 : -1;
+}
+
+void hs_run(void){
+	struct ble_npl_event *ev;
+
+
+	while((ev = ble_npl_eventq_get(nimble_port_get_dflt_eventq(), 0)) != 0x0)
+		ble_npl_event_run(ev);
+}
+
+int hs_att_req(void const *pdu, uint16_t len, uint8_t rsp_op){
+	size_t acl_pkts = hci_stats.acl_pkts;
+
+
+	if(hci_l2cap_rx(ATT_CID, pdu, len) != 0)
+		return -1;
+
+	hs_run();
+	hci_conn_event();
+	hs_run();
+
+	if(hci_stats.acl_pkts == acl_pkts || hci_stats.cid != ATT_CID || hci_stats.len == 0)
+		return -1;
+
+	return hci_stats.pdu[0] == rsp_op ? 0 : -1;
+}
+
+uint64_t hs_time_ns(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void hs_result(char const *name, uint64_t start, size_t n){
+	printf("%-32s %10.1f ns/op\n", name, (double)(hs_time_ns() - start) / n);
+}
+
+
+/* local functions */
+static int access(uint16_t conn, uint16_t attr, struct ble_gatt_access_ctxt *ctxt, void *arg){
+	void const *data = report;
+	uint16_t len = sizeof(report);
+
+
+	switch(ctxt->op){
+	case BLE_GATT_ACCESS_OP_WRITE_CHR:
+		return 0;
+
+	case BLE_GATT_ACCESS_OP_READ_DSC:
+		len = 2;
+		break;
+
+	default:
+		if(attr == hs.report_map){
+			data = report_map;
+			len = sizeof(report_map);
+		}
+		else if(attr == hs.battery){
+			data = &battery_level;
+			len = 1;
+		}
+	}
+
+	return os_mbuf_append(ctxt->om, data, len) == 0 ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+}
+
+static int gap_event(struct ble_gap_event *event, void *arg){
+	switch(event->type){
+	case BLE_GAP_EVENT_CONNECT:
+		if(event->connect.status == 0)
+			hs.conn = event->connect.conn_handle;
+		break;
+
+	case BLE_GAP_EVENT_DISCONNECT:
+		hs.conn = BLE_HS_CONN_HANDLE_NONE;
+		break;
+
+	case BLE_GAP_EVENT_SUBSCRIBE:
+		hs.subscribed++;
+		break;
+	}
+
+	return 0;
+}
+
+static void sync(void){
+	synced = true;
+}
@@ -0,0 +1,54 @@
+#ifndef NIMBLE_TEST_HS_H
+#define NIMBLE_TEST_HS_H
+
+
+// Harness running the NimBLE host on top of the loopback HCI transport. The
+// GATT database resembles the one of the firmware, i.e. a HID service with
+// keyboard, media and mouse input reports plus the device information and
+// battery services.
+#include <stdint.h>
+#include <stdio.h>
+#include "npl.h"
+#include "hci.h"
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define ATT_CID		0x4
+
+#define HS_REPORTS	3
+
+
+/* types */
+typedef struct{
+	uint16_t conn;					// connection handle, BLE_HS_CONN_HANDLE_NONE if disconnected
+	uint16_t report[HS_REPORTS];	// value handles of the input reports
+	uint16_t report_map;			// value handle of the report map
+	uint16_t battery;				// value handle of the battery level
+	size_t subscribed;				// number of subscribe events
+} hs_t;
+
+
+/* global variables */
+extern hs_t hs;
+
+
+/* prototypes */
+int hs_init(void);
+int hs_connect(void);
+int hs_subscribe(uint16_t val_handle);
+
+void hs_run(void);
+int hs_att_req(void const *pdu, uint16_t len, uint8_t rsp_op);
+
+uint64_t hs_time_ns(void);
+void hs_result(char const *name, uint64_t start, size_t n);
+
+
+#endif // NIMBLE_TEST_HS_H
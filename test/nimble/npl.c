@@ -0,0 +1,406 @@
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include "npl.h"
+#include "nimble/nimble/include/nimble/nimble_npl.h"
+#include "nimble/porting/nimble/include/nimble/nimble_port.h"
+
+
+/* local/static prototypes */
+static void callout_fire(union sigval val);
+static void deadline(struct timespec *ts, ble_npl_time_t tmo);
+
+
+/* static variables */
+// the critical section is a recursive lock shared by all threads, which allows
+// the mempool and mbuf tests to run concurrently on the non lock-free code
+static pthread_mutex_t critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static _Thread_local uint32_t critical_nest = 0;
+
+// event queues and semaphores block on conditions, which need a lock that is
+// not recursive
+static pthread_mutex_t npl_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct ble_npl_eventq eventq_dflt;
+
+
+/* global functions */
+struct ble_npl_eventq *nimble_port_get_dflt_eventq(void){
+	return &eventq_dflt;
+}
+
+bool ble_npl_os_started(void){
+	return true;
+}
+
+void *ble_npl_get_current_task_id(void){
+	return (void*)pthread_self();
+}
+
+void ble_npl_eventq_init(struct ble_npl_eventq *evq){
+	evq->head = 0x0;
+	evq->tail = 0x0;
+	pthread_cond_init(&evq->cond, 0x0);
+	evq->q = evq;
+}
+
+void ble_npl_eventq_deinit(struct ble_npl_eventq *evq){
+	pthread_cond_destroy(&evq->cond);
+	evq->q = 0x0;
+}
+
+struct ble_npl_event *ble_npl_eventq_get(struct ble_npl_eventq *evq, ble_npl_time_t tmo){
+	struct ble_npl_event *ev;
+	struct timespec ts;
+
+
+	deadline(&ts, tmo);
+	pthread_mutex_lock(&npl_lock);
+
+	while(evq->head == 0x0 && tmo != 0){
+		if(tmo == BLE_NPL_TIME_FOREVER)
+			pthread_cond_wait(&evq->cond, &npl_lock);
+		else if(pthread_cond_timedwait(&evq->cond, &npl_lock, &ts) == ETIMEDOUT)
+			break;
+	}
+
+	ev = evq->head;
+
+	if(ev != 0x0){
+		evq->head = ev->next;
+
+		if(evq->head == 0x0)
+			evq->tail = 0x0;
+
+		ev->next = 0x0;
+		ev->queued = false;
+	}
+
+	pthread_mutex_unlock(&npl_lock);
+
+	return ev;
+}
+
+void ble_npl_eventq_put(struct ble_npl_eventq *evq, struct ble_npl_event *ev){
+	pthread_mutex_lock(&npl_lock);
+
+	if(!ev->queued){
+		ev->queued = true;
+		ev->next = 0x0;
+
+		if(evq->tail != 0x0)
+			evq->tail->next = ev;
+		else
+			evq->head = ev;
+
+		evq->tail = ev;
+		pthread_cond_signal(&evq->cond);
+	}
+
+	pthread_mutex_unlock(&npl_lock);
+}
+
+void ble_npl_eventq_remove(struct ble_npl_eventq *evq, struct ble_npl_event *ev){
+	struct ble_npl_event *prev = 0x0;
+
+
+	pthread_mutex_lock(&npl_lock);
+
+	if(ev->queued){
+		for(struct ble_npl_event *e=evq->head; e!=0x0 && e!=ev; e=e->next)
+			prev = e;
+
+		if(prev != 0x0)
+			prev->next = ev->next;
+		else
+			evq->head = ev->next;
+
+		if(evq->tail == ev)
+			evq->tail = prev;
+
+		ev->next = 0x0;
+		ev->queued = false;
+	}
+
+	pthread_mutex_unlock(&npl_lock);
+}
+
+bool ble_npl_eventq_is_empty(struct ble_npl_eventq *evq){
+	return evq->head == 0x0;
+}
+
+void ble_npl_event_init(struct ble_npl_event *ev, ble_npl_event_fn *fn, void *arg){
+	ev->fn = fn;
+	ev->arg = arg;
+	ev->queued = false;
+	ev->next = 0x0;
+}
+
+void ble_npl_event_deinit(struct ble_npl_event *ev){
+}
+
+bool ble_npl_event_is_queued(struct ble_npl_event *ev){
+	return ev->queued;
+}
+
+void *ble_npl_event_get_arg(struct ble_npl_event *ev){
+	return ev->arg;
+}
+
+void ble_npl_event_set_arg(struct ble_npl_event *ev, void *arg){
+	ev->arg = arg;
+}
+
+void ble_npl_event_run(struct ble_npl_event *ev){
+	ev->fn(ev);
+}
+
+ble_npl_error_t ble_npl_mutex_init(struct ble_npl_mutex *mu){
+	pthread_mutexattr_t attr;
+
+
+	// the FreeRTOS port uses recursive mutexes as well
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&mu->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_error_t ble_npl_mutex_pend(struct ble_npl_mutex *mu, ble_npl_time_t timeout){
+	struct timespec ts;
+
+
+	if(timeout == BLE_NPL_TIME_FOREVER)
+		return pthread_mutex_lock(&mu->mutex) == 0 ? BLE_NPL_OK : BLE_NPL_ERROR;
+
+	deadline(&ts, timeout);
+
+	return pthread_mutex_timedlock(&mu->mutex, &ts) == 0 ? BLE_NPL_OK : BLE_NPL_TIMEOUT;
+}
+
+ble_npl_error_t ble_npl_mutex_release(struct ble_npl_mutex *mu){
+	return pthread_mutex_unlock(&mu->mutex) == 0 ? BLE_NPL_OK : BLE_NPL_BAD_MUTEX;
+}
+
+ble_npl_error_t ble_npl_mutex_deinit(struct ble_npl_mutex *mu){
+	pthread_mutex_destroy(&mu->mutex);
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_error_t ble_npl_sem_init(struct ble_npl_sem *sem, uint16_t tokens){
+	sem->tokens = tokens;
+	pthread_cond_init(&sem->cond, 0x0);
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_error_t ble_npl_sem_pend(struct ble_npl_sem *sem, ble_npl_time_t timeout){
+	ble_npl_error_t r = BLE_NPL_OK;
+	struct timespec ts;
+
+
+	deadline(&ts, timeout);
+	pthread_mutex_lock(&npl_lock);
+
+	while(sem->tokens == 0){
+		if(timeout == 0){
+			r = BLE_NPL_TIMEOUT;
+			break;
+		}
+
+		if(timeout == BLE_NPL_TIME_FOREVER)
+			pthread_cond_wait(&sem->cond, &npl_lock);
+		else if(pthread_cond_timedwait(&sem->cond, &npl_lock, &ts) == ETIMEDOUT && sem->tokens == 0){
+			r = BLE_NPL_TIMEOUT;
+			break;
+		}
+	}
+
+	if(r == BLE_NPL_OK)
+		sem->tokens--;
+
+	pthread_mutex_unlock(&npl_lock);
+
+	return r;
+}
+
+ble_npl_error_t ble_npl_sem_release(struct ble_npl_sem *sem){
+	pthread_mutex_lock(&npl_lock);
+	sem->tokens++;
+	pthread_cond_signal(&sem->cond);
+	pthread_mutex_unlock(&npl_lock);
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_error_t ble_npl_sem_deinit(struct ble_npl_sem *sem){
+	pthread_cond_destroy(&sem->cond);
+
+	return BLE_NPL_OK;
+}
+
+uint16_t ble_npl_sem_get_count(struct ble_npl_sem *sem){
+	return sem->tokens;
+}
+
+void ble_npl_callout_init(struct ble_npl_callout *co, struct ble_npl_eventq *evq, ble_npl_event_fn *ev_cb, void *ev_arg){
+	struct sigevent sev;
+
+
+	memset(co, 0, sizeof(*co));
+	memset(&sev, 0, sizeof(sev));
+
+	co->evq = evq;
+	ble_npl_event_init(&co->ev, ev_cb, ev_arg);
+
+	// expired callouts are handed to their event queue from the timer thread,
+	// similar to the FreeRTOS timer task
+	sev.sigev_notify = SIGEV_THREAD;
+	sev.sigev_notify_function = callout_fire;
+	sev.sigev_value.sival_ptr = co;
+
+	timer_create(CLOCK_MONOTONIC, &sev, &co->timer);
+}
+
+void ble_npl_callout_deinit(struct ble_npl_callout *co){
+	ble_npl_callout_stop(co);
+	timer_delete(co->timer);
+}
+
+ble_npl_error_t ble_npl_callout_reset(struct ble_npl_callout *co, ble_npl_time_t ticks){
+	struct itimerspec its;
+
+
+	memset(&its, 0, sizeof(its));
+
+	// a zero timeout would disarm the timer
+	if(ticks == 0)
+		ticks = 1;
+
+	its.it_value.tv_sec = ticks / 1000;
+	its.it_value.tv_nsec = (ticks % 1000) * 1000000;
+
+	co->ticks = ble_npl_time_get() + ticks;
+	co->active = true;
+
+	if(timer_settime(co->timer, 0, &its, 0x0) != 0)
+		return BLE_NPL_EINVAL;
+
+	return BLE_NPL_OK;
+}
+
+void ble_npl_callout_stop(struct ble_npl_callout *co){
+	struct itimerspec its;
+
+
+	memset(&its, 0, sizeof(its));
+	timer_settime(co->timer, 0, &its, 0x0);
+	co->active = false;
+}
+
+bool ble_npl_callout_is_active(struct ble_npl_callout *co){
+	return co->active;
+}
+
+ble_npl_time_t ble_npl_callout_get_ticks(struct ble_npl_callout *co){
+	return co->ticks;
+}
+
+ble_npl_time_t ble_npl_callout_remaining_ticks(struct ble_npl_callout *co, ble_npl_time_t time){
+	if(!co->active || (ble_npl_stime_t)(co->ticks - time) <= 0)
+		return 0;
+
+	return co->ticks - time;
+}
+
+void ble_npl_callout_set_arg(struct ble_npl_callout *co, void *arg){
+	co->ev.arg = arg;
+}
+
+ble_npl_time_t ble_npl_time_get(void){
+	struct timespec ts;
+
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+ble_npl_error_t ble_npl_time_ms_to_ticks(uint32_t ms, ble_npl_time_t *out_ticks){
+	*out_ticks = ms;
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_error_t ble_npl_time_ticks_to_ms(ble_npl_time_t ticks, uint32_t *out_ms){
+	*out_ms = ticks;
+
+	return BLE_NPL_OK;
+}
+
+ble_npl_time_t ble_npl_time_ms_to_ticks32(uint32_t ms){
+	return ms;
+}
+
+uint32_t ble_npl_time_ticks_to_ms32(ble_npl_time_t ticks){
+	return ticks;
+}
+
+void ble_npl_time_delay(ble_npl_time_t ticks){
+	struct timespec ts = {
+		.tv_sec = ticks / 1000,
+		.tv_nsec = (ticks % 1000) * 1000000,
+	};
+
+
+	nanosleep(&ts, 0x0);
+}
+
+uint32_t ble_npl_hw_enter_critical(void){
+	pthread_mutex_lock(&critical);
+
+	return critical_nest++;
+}
+
+void ble_npl_hw_exit_critical(uint32_t ctx){
+	critical_nest = ctx;
+	pthread_mutex_unlock(&critical);
+}
+
+bool ble_npl_hw_is_in_critical(void){
+	return critical_nest > 0;
+}
+
+
+/* local functions */
+static void callout_fire(union sigval val){
+	struct ble_npl_callout *co = val.sival_ptr;
+
+
+	co->active = false;
+
+	if(co->evq != 0x0)
+		ble_npl_eventq_put(co->evq, &co->ev);
+	else
+		ble_npl_event_run(&co->ev);
+}
+
+static void deadline(struct timespec *ts, ble_npl_time_t tmo){
+	clock_gettime(CLOCK_REALTIME, ts);
+
+	if(tmo == 0 || tmo == BLE_NPL_TIME_FOREVER)
+		return;
+
+	ts->tv_sec += tmo / 1000;
+	ts->tv_nsec += (tmo % 1000) * 1000000;
+
+	if(ts->tv_nsec >= 1000000000){
+		ts->tv_sec++;
+		ts->tv_nsec -= 1000000000;
+	}
+}
@@ -0,0 +1,69 @@
+#ifndef NIMBLE_TEST_NPL_H
+#define NIMBLE_TEST_NPL_H
+
+
+// Host implementation of the NimBLE porting layer (NPL) on top of pthreads,
+// taking the place of the FreeRTOS port, i.e. it has to be included before any
+// NimBLE header. Timeouts and ticks are in milliseconds.
+#define _NIMBLE_NPL_OS_H_
+
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+
+/* macros */
+// 64-bit hosts need pointer alignment for the mempool free list
+#define BLE_NPL_OS_ALIGNMENT	(8)
+#define BLE_NPL_TIME_FOREVER	UINT32_MAX
+
+
+/* types */
+typedef uint32_t ble_npl_time_t;
+typedef int32_t ble_npl_stime_t;
+
+struct ble_npl_event;
+typedef void ble_npl_event_fn(struct ble_npl_event *ev);
+
+struct ble_npl_event{
+	bool queued;
+	ble_npl_event_fn *fn;
+	void *arg;
+	struct ble_npl_event *next;
+};
+
+struct ble_npl_eventq{
+	// non-null once initialised, like the queue handle of the FreeRTOS port
+	void *q;
+	struct ble_npl_event *head,
+						 *tail;
+	pthread_cond_t cond;
+};
+
+struct ble_npl_callout{
+	timer_t timer;
+	bool active;
+	ble_npl_time_t ticks;
+	struct ble_npl_eventq *evq;
+	struct ble_npl_event ev;
+};
+
+struct ble_npl_mutex{
+	pthread_mutex_t mutex;
+};
+
+struct ble_npl_sem{
+	uint16_t tokens;
+	pthread_cond_t cond;
+};
+
+
+/* prototypes */
+// functions the FreeRTOS port provides beyond nimble_npl.h
+void ble_npl_event_deinit(struct ble_npl_event *ev);
+void ble_npl_callout_deinit(struct ble_npl_callout *co);
+
+
+#endif // NIMBLE_TEST_NPL_H
@@ -0,0 +1,231 @@
+// Host test of the NimBLE porting layer mempool and mbuf code. The sources are
+// included directly to build them with the host NPL and the given mempool
+// configuration, cf. os_lockfree.c.
+#include "npl.h"
+#include "nimble/porting/nimble/src/os_mempool.c"
+#include "nimble/porting/nimble/src/os_mbuf.c"
+
+#include <pthread.h>
+#include <stdio.h>
+
+
+/* macros */
+#define CHECK(expr)({ \
+	if(!(expr)){ \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+		return -1; \
+	} \
+})
+
+#define POOL_BLOCKS		32
+#define POOL_BLOCK_SIZE	24
+
+#define MBUF_BLOCKS		16
+#define MBUF_BUF_SIZE	64
+#define MBUF_BLOCK_SIZE	(MBUF_BUF_SIZE + sizeof(struct os_mbuf))
+
+#define THREADS			4
+#define ITERATIONS		1000000
+
+
+/* local/static prototypes */
+static int test_mempool(void);
+static int test_mempool_threads(void);
+static int test_mbuf(void);
+
+static void *mempool_thread(void *arg);
+
+
+/* static variables */
+// the mempool stores block addresses as uint32_t, the test binary is hence
+// linked without PIE to keep the static pool buffers below 4 GiB
+static os_membuf_t pool_buf[OS_MEMPOOL_SIZE(POOL_BLOCKS, POOL_BLOCK_SIZE)];
+static struct os_mempool pool;
+
+static os_membuf_t mbuf_buf[OS_MEMPOOL_SIZE(MBUF_BLOCKS, MBUF_BLOCK_SIZE)];
+static struct os_mempool mbuf_mempool;
+static struct os_mbuf_pool mbuf_pool;
+
+
+/* global functions */
+int main(int argc, char **argv){
+	CHECK((uintptr_t)pool_buf <= UINT32_MAX && (uintptr_t)mbuf_buf <= UINT32_MAX);
+
+	printf("mempool: %s\n", OS_MEMPOOL_LOCKFREE ? "lock-free" : "critical section");
+
+	if(test_mempool() != 0
+	|| test_mempool_threads() != 0
+	|| test_mbuf() != 0
+	)
+		return 1;
+
+	return 0;
+}
+
+
+/* local functions */
+static int test_mempool(void){
+	void *blocks[POOL_BLOCKS];
+
+
+	CHECK(os_mempool_init(&pool, POOL_BLOCKS, POOL_BLOCK_SIZE, pool_buf, "pool") == OS_OK);
+	CHECK(pool.mp_num_free == POOL_BLOCKS);
+
+	// drain the pool, every block has to be a distinct block of the pool
+	for(size_t i=0; i<POOL_BLOCKS; i++){
+		blocks[i] = os_memblock_get(&pool);
+
+		CHECK(blocks[i] != 0x0);
+		CHECK(os_memblock_from(&pool, blocks[i]));
+
+		for(size_t j=0; j<i; j++)
+			CHECK(blocks[i] != blocks[j]);
+
+		memset(blocks[i], i, POOL_BLOCK_SIZE);
+	}
+
+	CHECK(os_memblock_get(&pool) == 0x0);
+	CHECK(pool.mp_num_free == 0);
+	CHECK(pool.mp_min_free == 0);
+
+	for(size_t i=0; i<POOL_BLOCKS; i++)
+		CHECK(os_memblock_put(&pool, blocks[i]) == OS_OK);
+
+	CHECK(pool.mp_num_free == POOL_BLOCKS);
+	CHECK(os_mempool_is_sane(&pool));
+
+	// the most recently freed block is handed out first
+	CHECK(os_memblock_get(&pool) == blocks[POOL_BLOCKS - 1]);
+	CHECK(os_memblock_put(&pool, blocks[POOL_BLOCKS - 1]) == OS_OK);
+
+	// a cleared pool is full again
+	CHECK(os_memblock_get(&pool) != 0x0);
+	CHECK(os_mempool_clear(&pool) == OS_OK);
+	CHECK(pool.mp_num_free == POOL_BLOCKS);
+	CHECK(os_mempool_is_sane(&pool));
+
+	CHECK(os_memblock_put(&pool, 0x0) == OS_INVALID_PARM);
+
+	return 0;
+}
+
+static int test_mempool_threads(void){
+	pthread_t threads[THREADS];
+	void *r;
+	void *blocks[POOL_BLOCKS];
+
+
+	CHECK(os_mempool_init(&pool, POOL_BLOCKS, POOL_BLOCK_SIZE, pool_buf, "pool") == OS_OK);
+
+	for(size_t i=0; i<THREADS; i++)
+		CHECK(pthread_create(threads + i, 0x0, mempool_thread, (void*)(i + 1)) == 0);
+
+	for(size_t i=0; i<THREADS; i++){
+		CHECK(pthread_join(threads[i], &r) == 0);
+		CHECK(r == 0x0);
+	}
+
+	// no block may have been lost or handed out twice, the free list is not
+	// walked by os_mempool_is_sane() since it might contain a loop
+	CHECK(pool.mp_num_free == POOL_BLOCKS);
+
+	for(size_t i=0; i<POOL_BLOCKS; i++){
+		blocks[i] = os_memblock_get(&pool);
+		CHECK(blocks[i] != 0x0);
+
+		for(size_t j=0; j<i; j++)
+			CHECK(blocks[i] != blocks[j]);
+	}
+
+	CHECK(os_memblock_get(&pool) == 0x0);
+
+	return 0;
+}
+
+static int test_mbuf(void){
+	uint8_t data[200],
+			out[sizeof(data)];
+	uint16_t len;
+	struct os_mbuf *om;
+
+
+	for(size_t i=0; i<sizeof(data); i++)
+		data[i] = i;
+
+	CHECK(os_mempool_init(&mbuf_mempool, MBUF_BLOCKS, MBUF_BLOCK_SIZE, mbuf_buf, "mbuf") == OS_OK);
+	CHECK(os_mbuf_pool_init(&mbuf_pool, &mbuf_mempool, MBUF_BLOCK_SIZE, MBUF_BLOCKS) == OS_OK);
+
+	om = os_mbuf_get_pkthdr(&mbuf_pool, 0);
+	CHECK(om != 0x0);
+
+	// append across several mbufs
+	CHECK(os_mbuf_append(om, data, sizeof(data)) == 0);
+	CHECK(OS_MBUF_PKTLEN(om) == sizeof(data));
+	CHECK(SLIST_NEXT(om, om_next) != 0x0);
+	CHECK(os_mbuf_cmpf(om, 0, data, sizeof(data)) == 0);
+
+	CHECK(os_mbuf_copydata(om, 10, 100, out) == 0);
+	CHECK(memcmp(out, data + 10, 100) == 0);
+	CHECK(os_mbuf_copydata(om, 150, 100, out) != 0);
+
+	// trim both ends
+	os_mbuf_adj(om, 5);
+	os_mbuf_adj(om, -5);
+	CHECK(OS_MBUF_PKTLEN(om) == sizeof(data) - 10);
+	CHECK(os_mbuf_cmpf(om, 0, data + 5, sizeof(data) - 10) == 0);
+
+	// make the first bytes contiguous across an mbuf boundary
+	len = om->om_len + 1;
+	om = os_mbuf_pullup(om, len);
+	CHECK(om != 0x0);
+	CHECK(om->om_len >= len);
+	CHECK(memcmp(om->om_data, data + 5, len) == 0);
+
+	om = os_mbuf_prepend(om, 5);
+	CHECK(om != 0x0);
+	memcpy(om->om_data, data, 5);
+	CHECK(os_mbuf_cmpf(om, 0, data, sizeof(data) - 5) == 0);
+
+	CHECK(os_mbuf_free_chain(om) == 0);
+	CHECK(mbuf_mempool.mp_num_free == MBUF_BLOCKS);
+
+	// exhaust the pool
+	om = os_mbuf_get_pkthdr(&mbuf_pool, 0);
+	CHECK(om != 0x0);
+
+	while(os_mbuf_append(om, data, sizeof(data)) == 0);
+
+	CHECK(mbuf_mempool.mp_num_free == 0);
+	CHECK(os_mbuf_free_chain(om) == 0);
+	CHECK(mbuf_mempool.mp_num_free == MBUF_BLOCKS);
+
+	return 0;
+}
+
+static void *mempool_thread(void *arg){
+	uint8_t tag = (uintptr_t)arg;
+	uint8_t *block;
+
+
+	for(size_t i=0; i<ITERATIONS; i++){
+		block = os_memblock_get(&pool);
+
+		if(block == 0x0)
+			continue;
+
+		// detect blocks handed out to several threads at once
+		memset(block + sizeof(void*), tag, POOL_BLOCK_SIZE - sizeof(void*));
+
+		for(size_t j=sizeof(void*); j<POOL_BLOCK_SIZE; j++){
+			if(block[j] != tag){
+				printf("block %p shared by threads %u and %u\n", block, tag, block[j]);
+				return (void*)-1;
+			}
+		}
+
+		if(os_memblock_put(&pool, block) != OS_OK)
+			return (void*)-1;
+	}
+
+	return 0x0;
+}
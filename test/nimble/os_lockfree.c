@@ -0,0 +1,4 @@
+// os.c with the lock-free mempool free list
+#define MYNEWT_VAL_OS_MEMPOOL_LOCKFREE	(1)
+
+#include "os.c"
@@ -0,0 +1,6 @@
+// tinycrypt as used by the security manager, cf. crypto_ecc.c
+#include "npl.h"
+
+#include "nimble/ext/tinycrypt/src/aes_encrypt.c"
+#include "nimble/ext/tinycrypt/src/cmac_mode.c"
+#include "nimble/ext/tinycrypt/src/utils.c"
@@ -0,0 +1,4 @@
+// ecc.c and ecc_dh.c both have a static g_rng_function, cf. crypto_ecc_dh.c
+#include "npl.h"
+
+#include "nimble/ext/tinycrypt/src/ecc.c"
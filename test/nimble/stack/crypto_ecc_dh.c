@@ -0,0 +1,4 @@
+// cf. crypto_ecc.c
+#include "npl.h"
+
+#include "nimble/ext/tinycrypt/src/ecc_dh.c"
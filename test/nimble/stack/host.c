@@ -0,0 +1,53 @@
+// Linux build of the NimBLE host, with the services and the RAM store used by
+// the firmware. The host sources are built as a single translation unit, only
+// ble_gatts_lcl.c is left out, it dumps the local database and clashes with
+// ble_gatts.c.
+#include "npl.h"
+
+#include "nimble/nimble/host/src/ble_att.c"
+#include "nimble/nimble/host/src/ble_att_clt.c"
+#include "nimble/nimble/host/src/ble_att_cmd.c"
+#include "nimble/nimble/host/src/ble_att_svr.c"
+#include "nimble/nimble/host/src/ble_eddystone.c"
+#include "nimble/nimble/host/src/ble_gap.c"
+#include "nimble/nimble/host/src/ble_gattc.c"
+#include "nimble/nimble/host/src/ble_gatts.c"
+#include "nimble/nimble/host/src/ble_hs.c"
+#include "nimble/nimble/host/src/ble_hs_adv.c"
+#include "nimble/nimble/host/src/ble_hs_atomic.c"
+#include "nimble/nimble/host/src/ble_hs_cfg.c"
+#include "nimble/nimble/host/src/ble_hs_conn.c"
+#include "nimble/nimble/host/src/ble_hs_flow.c"
+#include "nimble/nimble/host/src/ble_hs_hci.c"
+#include "nimble/nimble/host/src/ble_hs_hci_cmd.c"
+#include "nimble/nimble/host/src/ble_hs_hci_evt.c"
+#include "nimble/nimble/host/src/ble_hs_hci_util.c"
+#include "nimble/nimble/host/src/ble_hs_id.c"
+#include "nimble/nimble/host/src/ble_hs_log.c"
+#include "nimble/nimble/host/src/ble_hs_mbuf.c"
+#include "nimble/nimble/host/src/ble_hs_misc.c"
+#include "nimble/nimble/host/src/ble_hs_mqueue.c"
+#include "nimble/nimble/host/src/ble_hs_periodic_sync.c"
+#include "nimble/nimble/host/src/ble_hs_pvcy.c"
+#include "nimble/nimble/host/src/ble_hs_resolv.c"
+#include "nimble/nimble/host/src/ble_hs_shutdown.c"
+#include "nimble/nimble/host/src/ble_hs_startup.c"
+#include "nimble/nimble/host/src/ble_hs_stop.c"
+#include "nimble/nimble/host/src/ble_ibeacon.c"
+#include "nimble/nimble/host/src/ble_l2cap.c"
+#include "nimble/nimble/host/src/ble_l2cap_coc.c"
+#include "nimble/nimble/host/src/ble_l2cap_sig.c"
+#include "nimble/nimble/host/src/ble_l2cap_sig_cmd.c"
+#include "nimble/nimble/host/src/ble_monitor.c"
+#include "nimble/nimble/host/src/ble_sm.c"
+#include "nimble/nimble/host/src/ble_sm_alg.c"
+#include "nimble/nimble/host/src/ble_sm_cmd.c"
+#include "nimble/nimble/host/src/ble_sm_lgcy.c"
+#include "nimble/nimble/host/src/ble_sm_sc.c"
+#include "nimble/nimble/host/src/ble_store.c"
+#include "nimble/nimble/host/src/ble_store_util.c"
+#include "nimble/nimble/host/src/ble_uuid.c"
+#include "nimble/nimble/host/services/gap/src/ble_svc_gap.c"
+#include "nimble/nimble/host/services/gatt/src/ble_svc_gatt.c"
+#include "nimble/nimble/host/store/config/src/ble_store_config.c"
+#include "nimble/nimble/host/util/src/addr.c"
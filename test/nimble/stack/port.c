@@ -0,0 +1,7 @@
+// NimBLE porting layer, cf. port_msys.c
+#include "npl.h"
+
+#include "nimble/porting/nimble/src/os_mempool.c"
+#include "nimble/porting/nimble/src/os_mbuf.c"
+#include "nimble/porting/nimble/src/mem.c"
+#include "nimble/porting/nimble/src/endian.c"
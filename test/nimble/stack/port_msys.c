@@ -0,0 +1,4 @@
+// os_msys_init.c has its own static pool list that clashes with os_mbuf.c
+#include "npl.h"
+
+#include "nimble/porting/nimble/src/os_msys_init.c"
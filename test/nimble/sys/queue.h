@@ -0,0 +1,45 @@
+#ifndef NIMBLE_TEST_SYS_QUEUE_H
+#define NIMBLE_TEST_SYS_QUEUE_H
+
+
+// NimBLE expects the BSD sys/queue.h of newlib, add what glibc is missing
+#include_next <sys/queue.h>
+#include <stddef.h>
+
+
+/* macros */
+#ifndef STAILQ_LAST
+#define STAILQ_LAST(head, type, field) \
+	(STAILQ_EMPTY((head)) ? 0x0 : \
+		((struct type *)(void *)((char *)((head)->stqh_last) - offsetof(struct type, field))))
+#endif
+
+#ifndef STAILQ_REMOVE_AFTER
+#define STAILQ_REMOVE_AFTER(head, elm, field) do{ \
+	if((STAILQ_NEXT(elm, field) = STAILQ_NEXT(STAILQ_NEXT(elm, field), field)) == 0x0) \
+		(head)->stqh_last = &STAILQ_NEXT((elm), field); \
+}while(0)
+#endif
+
+// NimBLE os/queue.h provides its own circular queues
+#undef CIRCLEQ_HEAD
+#undef CIRCLEQ_HEAD_INITIALIZER
+#undef CIRCLEQ_ENTRY
+#undef CIRCLEQ_INIT
+#undef CIRCLEQ_INSERT_AFTER
+#undef CIRCLEQ_INSERT_BEFORE
+#undef CIRCLEQ_INSERT_HEAD
+#undef CIRCLEQ_INSERT_TAIL
+#undef CIRCLEQ_REMOVE
+#undef CIRCLEQ_FOREACH
+#undef CIRCLEQ_FOREACH_REVERSE
+#undef CIRCLEQ_EMPTY
+#undef CIRCLEQ_FIRST
+#undef CIRCLEQ_LAST
+#undef CIRCLEQ_NEXT
+#undef CIRCLEQ_PREV
+#undef CIRCLEQ_LOOP_NEXT
+#undef CIRCLEQ_LOOP_PREV
+
+
+#endif // NIMBLE_TEST_SYS_QUEUE_H